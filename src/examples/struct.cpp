@@ -12,6 +12,7 @@
 #include <shift/buffer/static_buffer.hpp>
 #include <shift/buffer/vector.hpp>
 #include <shift/operator/universal.hpp>
+#include <shift/schema.hpp>
 
 #include <examples/utility.hpp>
 
@@ -90,6 +91,17 @@ CoderType& operator << (CoderType& msg, const test_struct& obj) {
 	return msg;
 }
 
+/*
+ * the layout of test_struct, from which the codec is generated
+ */
+typedef shift::schema< test_struct
+                     , shift::field<test_struct, uint8_t, &test_struct::t1, 0   >
+                     , shift::field<test_struct, uint2_t, &test_struct::t2, 1, 7>
+                     , shift::field<test_struct, uint3_t, &test_struct::t3, 1, 2>
+                     , shift::field<test_struct, bool   , &test_struct::t4, 2, 3>
+                     , shift::field<test_struct, float  , &test_struct::t5, 3   >
+                     > test_struct_schema;
+
 CODE_SAMPLE(universal_operator, "universal operator for a test struct", "struct", "universal operator") {
 
 	typedef shift::sink<little_endian, shift::static_buffer<64> > sink_type;
@@ -177,4 +189,31 @@ CODE_SAMPLE(free_serialize_function, "free function for serialization", "struct"
 	obj_deserialized.print("\ndeserialized:");
 }
 
+CODE_SAMPLE(struct_schema, "schema of a test struct", "struct", "schema") {
+	typedef shift::sink<little_endian, shift::static_buffer<64> > sink_type;
+	sink_type sink_inst;
+	test_struct obj(129, 3, 4, true, 3.14);
+
+	try {
+		test_struct_schema::encode(sink_inst, obj);
+	} catch (shift::out_of_range& e) {
+		std::cout << e.what() << " " << e.file() << " " << e.line() << std::endl;
+	}
+
+	typedef source<little_endian> source_type;
+	source_type source(sink_inst.buffer(), sink_inst.size());
+	test_struct obj_deserialized;
+
+	try {
+		test_struct_schema::decode(source, obj_deserialized);
+	} catch (shift::out_of_range& e) {
+		std::cout << e.what() << " " << e.file() << " " << e.line() << std::endl;
+	}
+
+	example::debug_print(std::cout, sink_inst);
+	std::cout << "record size: " << test_struct_schema::size << std::endl;
+	obj.print("\noriginal:");
+	obj_deserialized.print("\ndeserialized:");
+}
+
 } // anonymous namespace
@@ -0,0 +1,141 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_BIT_READER_HPP_
+#define SHIFT_BIT_READER_HPP_
+
+#include <cstddef>
+#include <cstring>
+
+#include <shift/exception.hpp>
+#include <shift/types/byte.hpp>
+#include <shift/types/cstdint.hpp>
+#include <shift/types/fixed_width_uint.hpp>
+#include <shift/buffer_position.hpp>
+#include <shift/detail/endian_reversal.hpp>
+#include <shift/detail/stream_operator_interface.hpp>
+
+namespace shift {
+
+/*
+ * sequential bit reader: extracts consecutive fields without padding, starting at the current position
+ * of the source. the next bits are kept left aligned in a 64 bit window, which is refilled with a single
+ * 8 byte load; only the last bytes of the buffer are fetched one by one.
+ * align() moves the source to the beginning of the byte following the extracted bits.
+ */
+template<typename SourceType>
+class bit_reader {
+public:
+
+	typedef SourceType source_type;
+
+	explicit bit_reader(source_type& source)
+	: source_(source)
+	, bit_offset_()
+	, window_(0)
+	, n_bits_(0)
+	{
+		const buffer_position& pos = interface_type::get_position(source_);
+		bit_offset_ = pos.byte_index * 8 + (7 - pos.bit_index);
+	}
+
+	template<typename IntType, unsigned int NumBits>
+	IntType read() {
+		shift::uint64_t raw = 0;
+		if (NumBits > max_fetch_bits) {
+			raw = fetch(NumBits - 32) << 32;
+			raw = raw | fetch(32);
+		} else {
+			raw = fetch(NumBits);
+		}
+		const IntType value = static_cast<IntType>(raw);
+		return source_type::requires_endianness_conversion() ? detail::endian_reverse(value) : value;
+	}
+
+	template<typename IntType, unsigned int NumBits>
+	bit_reader& read(fixed_width_uint<IntType, NumBits>& value) {
+		value = read<IntType, NumBits>();
+		return *this;
+	}
+
+	bit_reader& read(bool& value) {
+		value = fetch(1) != 0;
+		return *this;
+	}
+
+	void align() {
+		interface_type::set_position(source_, buffer_position((bit_offset_ + 7) / 8, 7));
+	}
+
+private:
+
+	typedef detail::istream_operator_interface<source_type> interface_type;
+
+	/*
+	 * a refill at an arbitrary bit offset provides at least 57 bits
+	 */
+	static const unsigned int max_fetch_bits = 57;
+
+	shift::uint64_t fetch(const unsigned int n_bits) {
+		if (n_bits > n_bits_)
+			refill(n_bits);
+		const shift::uint64_t value = window_ >> (64 - n_bits);
+		window_      = window_ << n_bits;
+		n_bits_     -= n_bits;
+		bit_offset_ += n_bits;
+		return value;
+	}
+
+	/*
+	 * only the bytes of the field are requested, so that a reader-backed source does not wait for
+	 * input beyond it; the rest of the window is filled with the bytes that are already available
+	 */
+	void refill(const unsigned int n_bits) {
+		const std::size_t  byte        = bit_offset_ / 8;
+		const unsigned int offset      = bit_offset_ % 8;
+		const std::size_t  n_requested = interface_type::request(source_, byte, (offset + n_bits + 7) / 8);
+		const std::size_t  n_window    = n_requested > 0 ? interface_type::available(source_, byte) : 0;
+		const std::size_t  n_available = n_window < 8 ? n_window : 8;
+		const byte_type*   p           = interface_type::location(source_, byte);
+
+		if (n_available == 8) {
+			shift::uint64_t encoded;
+			std::memcpy(&encoded, p, 8);
+			window_  = detail::convert_byte_order<big_endian>(encoded) << offset;
+			n_bits_  = 64 - offset;
+			return;
+		}
+
+		const std::size_t size = source_.size();
+		if (bit_offset_ + n_bits > (byte + n_available) * 8)
+			SHIFT_THROW(out_of_range(byte < size ? size : byte, 0, size));
+
+		window_ = 0;
+		for (std::size_t i=0; i<n_available; ++i)
+			window_ = window_ | static_cast<shift::uint64_t>(p[i]) << (56 - 8 * i);
+		window_  = window_ << offset;
+		n_bits_  = n_available * 8 - offset;
+	}
+
+	source_type&    source_;
+	std::size_t     bit_offset_;
+	shift::uint64_t window_;
+	unsigned int    n_bits_;
+};
+
+template<typename SourceType, typename IntType, unsigned int NumBits>
+bit_reader<SourceType>& operator >> (bit_reader<SourceType>& reader, fixed_width_uint<IntType, NumBits>& value) {
+	return reader.read(value);
+}
+
+template<typename SourceType>
+bit_reader<SourceType>& operator >> (bit_reader<SourceType>& reader, bool& value) {
+	return reader.read(value);
+}
+
+} // shift
+
+#endif /* SHIFT_BIT_READER_HPP_ */
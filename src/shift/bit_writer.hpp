@@ -0,0 +1,128 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_BIT_WRITER_HPP_
+#define SHIFT_BIT_WRITER_HPP_
+
+#include <shift/types/byte.hpp>
+#include <shift/types/cstdint.hpp>
+#include <shift/types/fixed_width_uint.hpp>
+#include <shift/buffer_position.hpp>
+#include <shift/detail/bit_mask.hpp>
+#include <shift/detail/endian_reversal.hpp>
+#include <shift/detail/stream_operator_interface.hpp>
+
+namespace shift {
+
+/*
+ * sequential bit writer: consecutive fields are packed without padding, starting at the current position
+ * of the sink. pending bits are collected in a 64 bit register and stored with one write per full word.
+ * flush() writes the remaining bits and leaves the sink at the beginning of the next byte.
+ *
+ * the sink must not be used directly while bits are pending.
+ */
+template<typename SinkType>
+class bit_writer {
+public:
+
+	typedef SinkType sink_type;
+
+	explicit bit_writer(sink_type& sink)
+	: sink_(sink)
+	, register_(0)
+	, n_bits_(0)
+	{
+		const buffer_position& pos = interface_type::get_position(sink_);
+		if (pos.bit_index < 7) {
+			n_bits_   = 7 - pos.bit_index;
+			register_ = read_if_written(pos.byte_index) >> (pos.bit_index + 1);
+		}
+	}
+
+	template<typename IntType, unsigned int NumBits>
+	bit_writer& write(const fixed_width_uint<IntType, NumBits> value) {
+		const IntType v = sink_type::requires_endianness_conversion() ? detail::endian_reverse(*value) : *value;
+		push(static_cast<shift::uint64_t>(v) & detail::bit_mask_all_bits<NumBits, shift::uint64_t>::value, NumBits);
+		return *this;
+	}
+
+	bit_writer& write(bool value) {
+		push(value ? 1 : 0, 1);
+		return *this;
+	}
+
+	void flush() {
+		const unsigned int n_bytes = n_bits_ / 8;
+		const unsigned int n_tail  = n_bits_ % 8;
+
+		if (n_bytes > 0) {
+			byte_type bytes[8];
+			for (unsigned int i=0; i<n_bytes; ++i)
+				bytes[i] = static_cast<byte_type>(register_ >> (n_bits_ - 8 * (i+1)));
+			interface_type::write_array(sink_, bytes, n_bytes);
+		}
+
+		if (n_tail > 0) {
+			const std::size_t index = interface_type::get_position(sink_).byte_index;
+			const byte_type   kept  = read_if_written(index) & detail::bit_mask::get(8 - n_tail);
+			interface_type::write(sink_, static_cast<byte_type>(kept | static_cast<byte_type>(register_ << (8 - n_tail))));
+		}
+
+		register_ = 0;
+		n_bits_   = 0;
+	}
+
+private:
+
+	typedef detail::ostream_operator_interface<sink_type> interface_type;
+
+	/*
+	 * bytes beyond the size of the sink have not been written yet and are known to be zero
+	 */
+	byte_type read_if_written(std::size_t index) {
+		return index < sink_.size() ? interface_type::read(sink_, index) : 0;
+	}
+
+	/*
+	 * value is right aligned and holds no bits above n_bits
+	 */
+	void push(const shift::uint64_t value, const unsigned int n_bits) {
+		const unsigned int n_free = 64 - n_bits_;
+		if (n_bits < n_free) {
+			register_ = (register_ << n_bits) | value;
+			n_bits_  += n_bits;
+			return;
+		}
+
+		const unsigned int n_rest = n_bits - n_free;
+		store_word(n_free == 64 ? value : (register_ << n_free) | (value >> n_rest));
+		register_ = n_rest > 0 ? value & (~shift::uint64_t(0) >> (64 - n_rest)) : 0;
+		n_bits_   = n_rest;
+	}
+
+	void store_word(const shift::uint64_t word) {
+		const shift::uint64_t encoded = detail::convert_byte_order<big_endian>(word);
+		interface_type::write_array(sink_, reinterpret_cast<const byte_type*>(&encoded), 8);
+	}
+
+	sink_type&      sink_;
+	shift::uint64_t register_;
+	unsigned int    n_bits_;
+};
+
+template<typename SinkType, typename IntType, unsigned int NumBits>
+bit_writer<SinkType>& operator << (bit_writer<SinkType>& writer, const fixed_width_uint<IntType, NumBits> value) {
+	return writer.write(value);
+}
+
+template<typename SinkType>
+bit_writer<SinkType>& operator << (bit_writer<SinkType>& writer, bool value) {
+	return writer.write(value);
+}
+
+} // shift
+
+#endif /* SHIFT_BIT_WRITER_HPP_ */
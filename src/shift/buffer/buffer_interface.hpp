@@ -44,6 +44,14 @@ public:
 		std::memset(reinterpret_cast<void*>(buffer_), 0, size_);
 	}
 
+	/*
+	 * makes [begin_index, end_index) writable, returns the location of begin_index
+	 */
+	byte_type* reserve(std::size_t begin_index, std::size_t end_index) {
+		if (end_index > begin_index) SHIFT_THROW_ON_INDEX_OUT_OF_RANGE(end_index - 1, 0, size_);
+		return buffer_ + begin_index;
+	}
+
 	const byte_type& at(unsigned int current_index) const {
 		SHIFT_THROW_ON_INDEX_OUT_OF_RANGE(current_index, 0, size_);
 		return buffer_[current_index];
@@ -0,0 +1,59 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_BUFFER_COUNTING_BUFFER_HPP_
+#define SHIFT_BUFFER_COUNTING_BUFFER_HPP_
+
+#include <cstddef>
+
+#include <shift/types/byte.hpp>
+#include <shift/detail/buffer_traits.hpp>
+
+namespace shift {
+
+/*
+ * discards the bytes written to it, so a sink over it runs the same operators as any other sink
+ * but only advances its position and size: sink.size() is the exact encoded size. bytes read back
+ * are 0, nothing is reserved (reservations write through to the sink itself) and buffer() is NULL.
+ */
+class counting_buffer {
+public:
+
+	struct initialization_params {};
+
+	explicit counting_buffer(initialization_params = initialization_params()) {}
+
+	const byte_type* buffer() const {
+		return NULL;
+	}
+
+	void clear() {}
+
+	byte_type* reserve(std::size_t, std::size_t) {
+		return NULL;
+	}
+
+	const byte_type& at(std::size_t) const {
+		static const byte_type zero = 0;
+		return zero;
+	}
+
+	std::size_t write(byte_type, std::size_t current_index) {
+		return current_index + 1;
+	}
+
+	std::size_t write(const byte_type*, std::size_t current_index, std::size_t n) {
+		return current_index + n;
+	}
+
+	std::size_t reverse_write(const byte_type*, std::size_t current_index, std::size_t n) {
+		return current_index + n;
+	}
+};
+
+} // shift
+
+#endif /* SHIFT_BUFFER_COUNTING_BUFFER_HPP_ */
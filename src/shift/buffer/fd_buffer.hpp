@@ -0,0 +1,304 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_BUFFER_FD_BUFFER_HPP_
+#define SHIFT_BUFFER_FD_BUFFER_HPP_
+
+#include <cerrno>
+#include <cstring>
+#include <cstddef>
+#include <vector>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <shift/exception.hpp>
+#include <shift/types/byte.hpp>
+#include <shift/sink.hpp>
+#include <shift/detail/utility.hpp>
+#include <shift/detail/stream_operator_interface.hpp>
+
+namespace shift {
+
+/*
+ * streaming buffer that writes to a posix file descriptor. the data is kept in n_chunks separate
+ * chunks of chunk_size bytes. when a write crosses into a new chunk and no chunk is free, all
+ * completed chunks are handed to the file descriptor with a single writev and their buffers are
+ * reused. positions in chunks that have not been written out, including earlier ones, stay
+ * writable; writing to a position that has already been flushed throws out_of_range. a reservation
+ * has to fit into one chunk: at the end of the data a chunk is closed early so that the reservation
+ * starts a new one.
+ *
+ * indices are stream offsets. buffer() points to the first chunk that has not been flushed, which
+ * starts at offset flushed(). use shift::flush(sink) to write the end of the stream; the destructor
+ * only writes out what is left in the chunks. the file descriptor is not owned. clear() discards the
+ * chunks and restarts the offsets at 0, the next stream is appended to what has been flushed.
+ */
+class fd_buffer {
+public:
+
+	static const std::size_t default_chunk_size = 64 * 1024;
+	static const std::size_t default_n_chunks   = 16;
+
+	struct initialization_params {
+		initialization_params(                                                                                      ) : fd(-1), chunk_size(default_chunk_size), n_chunks(default_n_chunks) {}
+		initialization_params(int fd, std::size_t chunk_size = default_chunk_size, std::size_t n_chunks = default_n_chunks) : fd(fd), chunk_size(chunk_size        ), n_chunks(n_chunks        ) {}
+		int         fd;
+		std::size_t chunk_size;
+		std::size_t n_chunks;
+	};
+
+	explicit fd_buffer(initialization_params params = initialization_params())
+	: fd_        (params.fd)
+	, chunk_size_(params.chunk_size)
+	, offset_    (0)
+	{
+		if (fd_ < 0                                        ) SHIFT_THROW(not_initialized("fd_buffer::fd_buffer() : invalid file descriptor passed"));
+		if (params.chunk_size == 0 || params.n_chunks == 0) SHIFT_THROW(not_initialized("fd_buffer::fd_buffer() : chunk_size and n_chunks must not be zero"));
+		storage_.resize(params.chunk_size * params.n_chunks);
+		chunks_ .reserve(params.n_chunks);
+		for (std::size_t i=params.n_chunks; i>0; --i)
+			free_.push_back(&storage_[(i - 1) * chunk_size_]);
+	}
+
+	~fd_buffer() {
+		try {
+			flush(end());
+		} catch (...) {
+		}
+	}
+
+	const byte_type* buffer() const {
+		return chunks_.empty() ? NULL : chunks_.front().data;
+	}
+
+	std::size_t flushed() const {
+		return offset_;
+	}
+
+	void clear() {
+		recycle();
+		offset_ = 0;
+	}
+
+	/*
+	 * writes [flushed(), end_index) to the file descriptor and discards the rest of the chunks
+	 */
+	void flush(std::size_t end_index) {
+		if (end_index > end())
+			locate(end_index);
+		write_out(end_index);
+	}
+
+	/*
+	 * makes [begin_index, end_index) writable, returns the location of begin_index
+	 */
+	byte_type* reserve(std::size_t begin_index, std::size_t end_index) {
+		if (end_index - begin_index > chunk_size_)
+			SHIFT_THROW(out_of_range(end_index - 1, begin_index, begin_index + chunk_size_));
+
+		const std::size_t k = locate(begin_index);
+		if (end_index > chunk_end(k)) {
+			if (k + 1 < chunks_.size() || begin_index < end())
+				SHIFT_THROW(out_of_range(end_index - 1, chunks_[k].offset, chunk_end(k)));
+			append_chunk(begin_index);
+		}
+
+		std::size_t n = end_index - begin_index;
+		return writable(begin_index, n);
+	}
+
+	const byte_type& at(std::size_t current_index) const {
+		SHIFT_THROW_ON_INDEX_OUT_OF_RANGE(current_index, offset_, end());
+		std::size_t k = chunks_.size() - 1;
+		while (chunks_[k].offset > current_index)
+			--k;
+		return chunks_[k].data[current_index - chunks_[k].offset];
+	}
+
+	std::size_t write(byte_type value, std::size_t current_index) {
+		std::size_t n = 1;
+		*writable(current_index, n) = value;
+		return ++current_index;
+	}
+
+	std::size_t write(const byte_type* p, std::size_t current_index, std::size_t n) {
+		while (n > 0) {
+			std::size_t n_piece = n;
+			byte_type*  location = writable(current_index, n_piece);
+			std::memcpy(location, p, n_piece);
+			p             += n_piece;
+			current_index += n_piece;
+			n             -= n_piece;
+		}
+		return current_index;
+	}
+
+	std::size_t reverse_write(const byte_type* p, std::size_t current_index, std::size_t n) {
+		while (n > 0) {
+			std::size_t n_piece = n;
+			byte_type*  location = writable(current_index, n_piece);
+			detail::reverse_copy(p + n - n_piece, p + n, location);
+			current_index += n_piece;
+			n             -= n_piece;
+		}
+		return current_index;
+	}
+
+private:
+
+	fd_buffer(const fd_buffer&);
+	fd_buffer& operator=(const fd_buffer&);
+
+	static const int max_iovecs = 64;
+
+	/*
+	 * the bytes [offset, offset + size) of the stream. only the last chunk grows, up to chunk_size
+	 */
+	struct chunk {
+		byte_type*  data;
+		std::size_t offset;
+		std::size_t size;
+	};
+
+	std::size_t end() const {
+		return chunks_.empty() ? offset_ : chunks_.back().offset + chunks_.back().size;
+	}
+
+	/*
+	 * the index after the last position that can be written in the k-th chunk
+	 */
+	std::size_t chunk_end(std::size_t k) const {
+		return k + 1 < chunks_.size() ? chunks_[k].offset + chunks_[k].size : chunks_[k].offset + chunk_size_;
+	}
+
+	/*
+	 * returns the chunk that holds index. beyond the end, the chunks are filled with zeros up to index
+	 */
+	std::size_t locate(std::size_t index) {
+		if (index < offset_)
+			SHIFT_THROW(out_of_range(index, offset_, end()));
+
+		if (index < end()) {
+			std::size_t k = chunks_.size() - 1;
+			while (chunks_[k].offset > index)
+				--k;
+			return k;
+		}
+
+		for (;;) {
+			if (chunks_.empty() || chunks_.back().size == chunk_size_)
+				append_chunk(end());
+			chunk& last = chunks_.back();
+			if (index < last.offset + chunk_size_) {
+				std::memset(last.data + last.size, 0, index - last.offset - last.size);
+				last.size = index - last.offset;
+				return chunks_.size() - 1;
+			}
+			std::memset(last.data + last.size, 0, chunk_size_ - last.size);
+			last.size = chunk_size_;
+		}
+	}
+
+	/*
+	 * returns the location of index and reduces n to the bytes that follow it in the same chunk
+	 */
+	byte_type* writable(std::size_t index, std::size_t& n) {
+		const std::size_t k   = locate(index);
+		const std::size_t end = chunk_end(k);
+		if (n > end - index)
+			n = end - index;
+
+		chunk& c = chunks_[k];
+		if (index + n - c.offset > c.size)
+			c.size = index + n - c.offset;
+		return c.data + (index - c.offset);
+	}
+
+	/*
+	 * completes the last chunk and starts a new one at offset, the completed chunks are written out
+	 * if no chunk is free
+	 */
+	void append_chunk(std::size_t offset) {
+		if (free_.empty())
+			write_out(end());
+
+		chunk c;
+		c.data   = free_.back();
+		c.offset = offset;
+		c.size   = 0;
+		free_.pop_back();
+		chunks_.push_back(c);
+	}
+
+	/*
+	 * writes the chunks up to end_index with writev and puts all chunks back on the free list
+	 */
+	void write_out(std::size_t end_index) {
+		iovec iov[max_iovecs];
+		int   n_iov = 0;
+		for (std::size_t k=0; k<chunks_.size() && chunks_[k].offset < end_index; ++k) {
+			const std::size_t n = end_index - chunks_[k].offset;
+			iov[n_iov].iov_base = chunks_[k].data;
+			iov[n_iov].iov_len  = n < chunks_[k].size ? n : chunks_[k].size;
+			if (++n_iov == max_iovecs) {
+				write_all(iov, n_iov);
+				n_iov = 0;
+			}
+		}
+		write_all(iov, n_iov);
+
+		recycle();
+		if (end_index > offset_)
+			offset_ = end_index;
+	}
+
+	void recycle() {
+		for (std::size_t k=chunks_.size(); k>0; --k)
+			free_.push_back(chunks_[k - 1].data);
+		chunks_.clear();
+	}
+
+	void write_all(iovec* iov, int n_iov) {
+		while (n_iov > 0) {
+			const ssize_t n_written = ::writev(fd_, iov, n_iov);
+			if (n_written < 0) {
+				if (errno == EINTR) continue;
+				SHIFT_THROW(io_error(std::string("fd_buffer: writev failed: ") + std::strerror(errno), errno));
+			}
+			std::size_t n = static_cast<std::size_t>(n_written);
+			while (n_iov > 0 && n >= iov->iov_len) {
+				n -= iov->iov_len;
+				++iov;
+				--n_iov;
+			}
+			if (n_iov > 0) {
+				iov->iov_base = static_cast<byte_type*>(iov->iov_base) + n;
+				iov->iov_len -= n;
+			}
+		}
+	}
+
+	int                     fd_;
+	std::size_t             chunk_size_;
+	std::size_t             offset_;
+	std::vector<byte_type>  storage_;
+	std::vector<chunk>      chunks_;
+	std::vector<byte_type*> free_;
+};
+
+/*
+ * writes all content of the sink that has not been flushed yet to the file descriptor
+ */
+template<endianness EncodingEndianness>
+void flush(sink<EncodingEndianness, fd_buffer>& sink_) {
+	typedef sink<EncodingEndianness, fd_buffer> sink_type;
+	detail::ostream_operator_interface<sink_type>::get_buffer(sink_).flush(sink_.size());
+}
+
+} // shift
+
+#endif /* SHIFT_BUFFER_FD_BUFFER_HPP_ */
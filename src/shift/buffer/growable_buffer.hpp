@@ -0,0 +1,148 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_BUFFER_GROWABLE_BUFFER_HPP_
+#define SHIFT_BUFFER_GROWABLE_BUFFER_HPP_
+
+#include <cstring>
+#include <cstddef>
+#include <shift/exception.hpp>
+#include <shift/types/byte.hpp>
+#include <shift/detail/utility.hpp>
+
+namespace shift {
+
+/*
+ * dynamically growing buffer: the capacity is doubled when exceeded and the storage is not
+ * initialized on allocation. bytes that are skipped by a write beyond the current end are set
+ * to zero, so [0, size()) always has defined content. reset() (and clear()) discard the content
+ * but keep the allocated memory for the next message.
+ */
+class growable_buffer {
+public:
+
+	static const std::size_t default_capacity = 128;
+
+	struct initialization_params {
+		initialization_params(                    ) : capacity(default_capacity) {}
+		initialization_params(std::size_t capacity) : capacity(capacity        ) {}
+		std::size_t capacity;
+	};
+
+	explicit growable_buffer(initialization_params params = initialization_params())
+	: buffer_  (params.capacity > 0 ? new byte_type[params.capacity] : NULL)
+	, capacity_(params.capacity)
+	, size_    (0)
+	{ }
+
+	growable_buffer(const growable_buffer& other)
+	: buffer_  (other.capacity_ > 0 ? new byte_type[other.capacity_] : NULL)
+	, capacity_(other.capacity_)
+	, size_    (other.size_)
+	{
+		if (size_ > 0) std::memcpy(buffer_, other.buffer_, size_);
+	}
+
+	growable_buffer& operator=(const growable_buffer& other) {
+		if (this != &other) {
+			size_ = 0;
+			if (other.size_ > capacity_) grow(other.size_);
+			if (other.size_ > 0) std::memcpy(buffer_, other.buffer_, other.size_);
+			size_ = other.size_;
+		}
+		return *this;
+	}
+
+	~growable_buffer() {
+		delete[] buffer_;
+	}
+
+	const byte_type* buffer() const {
+		return buffer_;
+	}
+
+	std::size_t size() const {
+		return size_;
+	}
+
+	std::size_t capacity() const {
+		return capacity_;
+	}
+
+	void reset() {
+		size_ = 0;
+	}
+
+	void clear() {
+		reset();
+	}
+
+	/*
+	 * makes [begin_index, end_index) writable, returns the location of begin_index
+	 */
+	byte_type* reserve(std::size_t begin_index, std::size_t end_index) {
+		prepare(end_index, end_index);
+		return buffer_ + begin_index;
+	}
+
+	const byte_type& at(std::size_t current_index) const {
+		SHIFT_THROW_ON_INDEX_OUT_OF_RANGE(current_index, 0, size_);
+		return buffer_[current_index];
+	}
+
+	std::size_t write(byte_type value, std::size_t current_index) {
+		prepare(current_index, current_index + 1);
+		buffer_[current_index] = value;
+		return ++current_index;
+	}
+
+	std::size_t write(const byte_type* p, std::size_t current_index, std::size_t n) {
+		prepare(current_index, current_index + n);
+		std::memcpy(buffer_ + current_index, p, n);
+		return current_index + n;
+	}
+
+	std::size_t reverse_write(const byte_type* p, std::size_t current_index, std::size_t n) {
+		prepare(current_index, current_index + n);
+		detail::reverse_copy(p, p+n, buffer_ + current_index);
+		return current_index + n;
+	}
+
+private:
+
+	/*
+	 * makes [0, end_index) available and zeroes the bytes between the current end and zero_end
+	 */
+	void prepare(std::size_t zero_end, std::size_t end_index) {
+		if (end_index <= size_)
+			return;
+		if (end_index > capacity_)
+			grow(end_index);
+		if (zero_end > size_)
+			std::memset(buffer_ + size_, 0, zero_end - size_);
+		size_ = end_index;
+	}
+
+	void grow(std::size_t min_capacity) {
+		std::size_t new_capacity = capacity_ > 0 ? capacity_ * 2 : default_capacity;
+		if (new_capacity < min_capacity) new_capacity = min_capacity;
+
+		byte_type* p = new byte_type[new_capacity];
+		if (size_ > 0) std::memcpy(p, buffer_, size_);
+		delete[] buffer_;
+
+		buffer_   = p;
+		capacity_ = new_capacity;
+	}
+
+	byte_type*  buffer_;
+	std::size_t capacity_;
+	std::size_t size_;
+};
+
+} // shift
+
+#endif /* SHIFT_BUFFER_GROWABLE_BUFFER_HPP_ */
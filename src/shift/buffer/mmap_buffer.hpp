@@ -0,0 +1,200 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_BUFFER_MMAP_BUFFER_HPP_
+#define SHIFT_BUFFER_MMAP_BUFFER_HPP_
+
+#include <cerrno>
+#include <cstring>
+#include <cstddef>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <shift/exception.hpp>
+#include <shift/types/byte.hpp>
+#include <shift/sink.hpp>
+#include <shift/detail/utility.hpp>
+#include <shift/detail/stream_operator_interface.hpp>
+
+namespace shift {
+
+/*
+ * buffer that is a shared memory mapping of a file, so the page cache holds the only copy of the
+ * encoded data. the file is truncated on construction and grown with posix_fallocate where
+ * available, so a full disk is reported as io_error instead of SIGBUS on a store, and with
+ * ftruncate otherwise. the mapping is extended with mremap where available and remapped
+ * otherwise; the capacity is doubled each time.
+ *
+ * the file is cut to the last byte written when the buffer is destroyed; shift::flush(sink) writes
+ * the mapping back and cuts the file to the size of the sink, the mapping keeps its capacity and
+ * writing may continue afterwards. cutting the file on destruction is best effort, a failure
+ * leaves it padded to the capacity without notice; flush before to get errors as io_error. the
+ * file descriptor is not owned.
+ */
+class mmap_buffer {
+public:
+
+	static const std::size_t default_capacity = 1024 * 1024;
+
+	struct initialization_params {
+		initialization_params(                                               ) : fd(-1), capacity(default_capacity) {}
+		initialization_params(int fd, std::size_t capacity = default_capacity) : fd(fd), capacity(capacity        ) {}
+		int         fd;
+		std::size_t capacity;
+	};
+
+	explicit mmap_buffer(initialization_params params = initialization_params())
+	: fd_       (params.fd)
+	, buffer_   (NULL)
+	, capacity_ (0)
+	, size_     (0)
+	, file_size_(0)
+	{
+		if (fd_ < 0) SHIFT_THROW(not_initialized("mmap_buffer::mmap_buffer() : invalid file descriptor passed"));
+		if (::ftruncate(fd_, 0) != 0) throw_io_error("ftruncate");
+		remap(params.capacity > 0 ? params.capacity : default_capacity);
+	}
+
+	~mmap_buffer() {
+		if (buffer_ != NULL) ::munmap(buffer_, capacity_);
+		if (::ftruncate(fd_, size_) != 0) {
+			// best effort, a destructor cannot report the error
+		}
+	}
+
+	const byte_type* buffer() const {
+		return buffer_;
+	}
+
+	std::size_t capacity() const {
+		return capacity_;
+	}
+
+	void clear() {
+		if (buffer_ != NULL)
+			std::memset(buffer_, 0, size_);
+		size_ = 0;
+	}
+
+	/*
+	 * writes the mapping back to the file and cuts the file to size bytes, the mapping is kept
+	 */
+	void flush(std::size_t size) {
+		if (size > 0 && ::msync(buffer_, size, MS_SYNC) != 0) throw_io_error("msync");
+		if (::ftruncate(fd_, size) != 0) throw_io_error("ftruncate");
+		file_size_ = size;
+		size_      = size;
+	}
+
+	/*
+	 * makes [begin_index, end_index) writable, returns the location of begin_index
+	 */
+	byte_type* reserve(std::size_t begin_index, std::size_t end_index) {
+		prepare(end_index);
+		return buffer_ + begin_index;
+	}
+
+	const byte_type& at(std::size_t current_index) const {
+		SHIFT_THROW_ON_INDEX_OUT_OF_RANGE(current_index, 0, capacity_);
+		return buffer_[current_index];
+	}
+
+	std::size_t write(byte_type value, std::size_t current_index) {
+		prepare(current_index + 1);
+		buffer_[current_index] = value;
+		return ++current_index;
+	}
+
+	std::size_t write(const byte_type* p, std::size_t current_index, std::size_t n) {
+		prepare(current_index + n);
+		std::memcpy(buffer_ + current_index, p, n);
+		return current_index + n;
+	}
+
+	std::size_t reverse_write(const byte_type* p, std::size_t current_index, std::size_t n) {
+		prepare(current_index + n);
+		detail::reverse_copy(p, p+n, buffer_ + current_index);
+		return current_index + n;
+	}
+
+private:
+
+	mmap_buffer(const mmap_buffer&);
+	mmap_buffer& operator=(const mmap_buffer&);
+
+	void prepare(std::size_t end_index) {
+		if (end_index > capacity_)
+			remap(capacity_ * 2 > end_index ? capacity_ * 2 : end_index);
+		else if (end_index > file_size_)
+			grow_file(capacity_);
+		if (end_index > size_)
+			size_ = end_index;
+	}
+
+	/*
+	 * grows the file to size bytes, the bytes added are zero. stores into the mapping beyond the end
+	 * of the file would raise SIGBUS
+	 */
+	void grow_file(std::size_t size) {
+#if defined _POSIX_ADVISORY_INFO && _POSIX_ADVISORY_INFO > 0
+		const int error_number = ::posix_fallocate(fd_, file_size_, size - file_size_);
+		if (error_number != 0) throw_io_error("posix_fallocate", error_number);
+#else
+		if (::ftruncate(fd_, size) != 0) throw_io_error("ftruncate");
+#endif
+		file_size_ = size;
+	}
+
+	/*
+	 * grows the file and the mapping to capacity bytes
+	 */
+	void remap(std::size_t capacity) {
+		grow_file(capacity);
+
+#if defined __linux__ && defined MREMAP_MAYMOVE
+		void* p = buffer_ != NULL ? ::mremap(buffer_, capacity_, capacity, MREMAP_MAYMOVE)
+		                          : ::mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+#else
+		if (buffer_ != NULL) ::munmap(buffer_, capacity_);
+		void* p = ::mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+#endif
+
+		if (p == MAP_FAILED) {
+			buffer_   = NULL;
+			capacity_ = 0;
+			throw_io_error("mmap");
+		}
+		buffer_   = static_cast<byte_type*>(p);
+		capacity_ = capacity;
+	}
+
+	static void throw_io_error(const char* function, int error_number = errno) {
+		SHIFT_THROW(io_error(std::string("mmap_buffer: ") + function + " failed: " + std::strerror(error_number), error_number));
+	}
+
+	int         fd_;
+	byte_type*  buffer_;
+	std::size_t capacity_;
+	std::size_t size_;
+	std::size_t file_size_;
+};
+
+/*
+ * cuts the mapped file to the size of the sink and writes the mapping back to it
+ */
+template<endianness EncodingEndianness>
+void flush(sink<EncodingEndianness, mmap_buffer>& sink_) {
+	typedef sink<EncodingEndianness, mmap_buffer> sink_type;
+	detail::ostream_operator_interface<sink_type>::get_buffer(sink_).flush(sink_.size());
+}
+
+} // shift
+
+#endif /* SHIFT_BUFFER_MMAP_BUFFER_HPP_ */
@@ -0,0 +1,79 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_BUFFER_UNCHECKED_BUFFER_HPP_
+#define SHIFT_BUFFER_UNCHECKED_BUFFER_HPP_
+
+#include <cstring>
+#include <cstddef>
+
+#include <shift/types/byte.hpp>
+#include <shift/detail/utility.hpp>
+
+namespace shift {
+
+/*
+ * writes into memory that has been reserved in another buffer, without any bounds checks.
+ * indices are those of the other buffer; p_begin is the location of begin_index. used by
+ * shift::reservation.
+ */
+class unchecked_buffer {
+public:
+
+	struct initialization_params {
+		initialization_params(                                           ) : p_begin(NULL   ), begin_index(0          ) {}
+		initialization_params(byte_type* p_begin, std::size_t begin_index) : p_begin(p_begin), begin_index(begin_index) {}
+		byte_type*  p_begin;
+		std::size_t begin_index;
+	};
+
+	explicit unchecked_buffer(initialization_params parameters = initialization_params())
+	: p_begin_    (parameters.p_begin    )
+	, begin_index_(parameters.begin_index)
+	{}
+
+	const byte_type* buffer() const {
+		return p_begin_;
+	}
+
+	void clear() {}
+
+	byte_type* reserve(std::size_t begin_index, std::size_t) {
+		return location(begin_index);
+	}
+
+	const byte_type& at(std::size_t current_index) const {
+		return p_begin_[current_index - begin_index_];
+	}
+
+	std::size_t write(byte_type value, std::size_t current_index) {
+		*location(current_index) = value;
+		return ++current_index;
+	}
+
+	std::size_t write(const byte_type* p, std::size_t current_index, std::size_t n) {
+		std::memcpy(location(current_index), p, n);
+		return current_index + n;
+	}
+
+	std::size_t reverse_write(const byte_type* p, std::size_t current_index, std::size_t n) {
+		detail::reverse_copy(p, p+n, location(current_index));
+		return current_index + n;
+	}
+
+private:
+
+	byte_type* location(std::size_t index) const {
+		return p_begin_ + (index - begin_index_);
+	}
+
+	byte_type*  p_begin_;
+	std::size_t begin_index_;
+};
+
+} // shift
+
+#endif /* SHIFT_BUFFER_UNCHECKED_BUFFER_HPP_ */
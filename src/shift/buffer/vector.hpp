@@ -50,6 +50,14 @@ public:
 		return ++current_index;
 	}
 
+	/*
+	 * makes [begin_index, end_index) writable, returns the location of begin_index
+	 */
+	byte_type* reserve(std::size_t begin_index, std::size_t end_index) {
+		if (end_index > begin_index) resize_if_required(end_index - 1);
+		return buffer_.empty() ? NULL : &buffer_[0] + begin_index;
+	}
+
 	const byte_type& at(unsigned int current_index) {
 		SHIFT_THROW_ON_INDEX_OUT_OF_RANGE(current_index, 0, buffer_.size());
 		return buffer_.at(current_index);
@@ -65,9 +73,7 @@ public:
 
 	std::size_t reverse_write(const byte_type* p, std::size_t current_index, std::size_t n) {
 		resize_if_required(current_index + n);
-		container_type::iterator it = buffer_.begin();
-		std::advance(it, current_index);
-		detail::reverse_copy(p, p+n, it);
+		detail::reverse_copy(p, p+n, &buffer_[current_index]);
 		return current_index + n;
 	}
 
@@ -13,6 +13,33 @@ struct variable_length {};
 
 struct no_size_field {};
 
+/*
+ * size as variable_length, the elements, integers of up to 4 bytes, in the stream vbyte format
+ */
+struct stream_vbyte {};
+
+/*
+ * size as variable_length, the elements, integers, as var uints of their zig zag encoded difference
+ * to the previous element or, for delta_of_delta_coding, of the difference of these differences
+ */
+struct delta_coding {};
+
+struct delta_of_delta_coding {};
+
+/*
+ * size as variable_length, the elements, fixed_width_uints of N bits, packed to N bits each
+ */
+struct bit_packed {};
+
+/*
+ * size as variable_length, the elements, integers, in blocks of their minimum and the offsets to it
+ * packed to the width of the largest one or, for patched_frame_of_reference, to a width that leaves
+ * the largest offsets as exceptions
+ */
+struct frame_of_reference {};
+
+struct patched_frame_of_reference {};
+
 template<unsigned int Size> struct static_size { static const unsigned int size = Size; };
 
 }
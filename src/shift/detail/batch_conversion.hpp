@@ -0,0 +1,137 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_DETAIL_BATCH_CONVERSION_HPP_
+#define SHIFT_DETAIL_BATCH_CONVERSION_HPP_
+
+#include <cstddef>
+
+#include <shift/types/cstdint.hpp>
+#include <shift/types/converter.hpp>
+
+#if defined __SSE2__
+	#include <emmintrin.h>
+#endif
+
+namespace shift {
+namespace detail {
+
+/*
+ * applies the static encode and decode functions of converters to arrays. the loops over the
+ * remaining values are left to the compiler to vectorize, conversions between float and int16_t
+ * have SSE2 kernels. like the converters, they saturate values beyond the range of int16_t and
+ * encode NaN as 0, so a value is encoded alike wherever it is in the array
+ */
+static const std::size_t batch_conversion_block_size = 256;
+
+template<typename ConverterType>
+struct conversion_kernel {
+	typedef typename ConverterType::decoded_type decoded_type;
+	typedef typename ConverterType::encoded_type encoded_type;
+	typedef typename ConverterType::params       params_type;
+
+	static std::size_t encode(const decoded_type*, std::size_t, const params_type&, encoded_type*) { return 0; }
+	static std::size_t decode(const encoded_type*, std::size_t, const params_type&, decoded_type*) { return 0; }
+};
+
+#if defined __SSE2__
+
+/*
+ * NaN lanes are zeroed and the others clamped to the range of int16_t before the conversion, as
+ * _mm_cvttps_epi32 gives 0x80000000 for values beyond the range of int32_t
+ */
+inline __m128i saturate_to_int32(__m128 v) {
+	const __m128 ordered = _mm_and_ps(v, _mm_cmpord_ps(v, v));
+	return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(ordered, _mm_set1_ps(-32768.f)), _mm_set1_ps(32767.f)));
+}
+
+inline __m128i saturate_to_int16(__m128 v0, __m128 v1) {
+	return _mm_packs_epi32(saturate_to_int32(v0), saturate_to_int32(v1));
+}
+
+inline __m128 int16_to_float(__m128i v) {
+	return _mm_cvtepi32_ps(_mm_srai_epi32(v, 16));
+}
+
+/*
+ * 8 values per step, the int16_t values are widened to the upper halves of 32 bit lanes
+ */
+template<typename Kernel>
+struct float_int16_conversion {
+	template<typename ParamsType>
+	static std::size_t encode(const float* values, std::size_t n, const ParamsType& p, shift::int16_t* encoded) {
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m128 v0 = Kernel::encode(_mm_loadu_ps(values + i    ), p);
+			const __m128 v1 = Kernel::encode(_mm_loadu_ps(values + i + 4), p);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(encoded + i), saturate_to_int16(v0, v1));
+		}
+		return i;
+	}
+
+	template<typename ParamsType>
+	static std::size_t decode(const shift::int16_t* encoded, std::size_t n, const ParamsType& p, float* values) {
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(encoded + i));
+			_mm_storeu_ps(values + i    , Kernel::decode(int16_to_float(_mm_unpacklo_epi16(v, v)), p));
+			_mm_storeu_ps(values + i + 4, Kernel::decode(int16_to_float(_mm_unpackhi_epi16(v, v)), p));
+		}
+		return i;
+	}
+};
+
+struct float_int16_scale_kernel {
+	template<typename ParamsType>
+	static __m128 encode(__m128 v, const ParamsType& p) { return _mm_mul_ps(v, _mm_set1_ps(p.factor)); }
+
+	template<typename ParamsType>
+	static __m128 decode(__m128 v, const ParamsType& p) { return _mm_div_ps(v, _mm_set1_ps(p.factor)); }
+};
+
+/*
+ * the bounds are the first operands of minps and maxps, which return their second operand if
+ * either is NaN, so NaN passes like in clamp_converter::encode
+ */
+struct float_int16_clamp_kernel {
+	template<typename ParamsType>
+	static __m128 encode(__m128 v, const ParamsType& p) { return _mm_min_ps(_mm_set1_ps(p.upper), _mm_max_ps(_mm_set1_ps(p.lower), v)); }
+
+	template<typename ParamsType>
+	static __m128 decode(__m128 v, const ParamsType&  ) { return v; }
+};
+
+template<>
+struct conversion_kernel<scale_converter<float, shift::int16_t, float> > : float_int16_conversion<float_int16_scale_kernel> {};
+
+template<>
+struct conversion_kernel<clamp_converter<float, shift::int16_t> > : float_int16_conversion<float_int16_clamp_kernel> {};
+
+#endif
+
+template<typename ConverterType>
+inline void encode_batch( const typename ConverterType::decoded_type* values
+                        , std::size_t                                 n
+                        , const typename ConverterType::params&       p
+                        , typename ConverterType::encoded_type*       encoded) {
+	const std::size_t n_vectorized = conversion_kernel<ConverterType>::encode(values, n, p, encoded);
+	for (std::size_t i=n_vectorized; i<n; ++i)
+		encoded[i] = ConverterType::encode(values[i], p);
+}
+
+template<typename ConverterType>
+inline void decode_batch( const typename ConverterType::encoded_type* encoded
+                        , std::size_t                                 n
+                        , const typename ConverterType::params&       p
+                        , typename ConverterType::decoded_type*       values) {
+	const std::size_t n_vectorized = conversion_kernel<ConverterType>::decode(encoded, n, p, values);
+	for (std::size_t i=n_vectorized; i<n; ++i)
+		values[i] = ConverterType::decode(encoded[i], p);
+}
+
+}} // shift::detail
+
+#endif /* SHIFT_DETAIL_BATCH_CONVERSION_HPP_ */
@@ -0,0 +1,234 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_DETAIL_BIT_PACKING_HPP_
+#define SHIFT_DETAIL_BIT_PACKING_HPP_
+
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+#include <shift/types/byte.hpp>
+#include <shift/types/cstdint.hpp>
+#include <shift/detail/endianness.hpp>
+#include <shift/detail/endian_reversal.hpp>
+
+#if defined __SSE4_1__
+	#include <smmintrin.h>
+#endif
+
+namespace shift {
+namespace detail {
+
+/*
+ * packed arrays of NumBits wide values: the values follow each other without padding, each with its
+ * most significant bit first, as written by bit_writer; the last byte is padded with zero bits.
+ * a block of 64 values takes 8 * NumBits bytes, so blocks always start at a byte boundary.
+ */
+static const std::size_t bit_packing_block_size = 64;
+
+template<unsigned int NumBits>
+struct packed_value { typedef typename uint_of_size<(NumBits <= 32 ? 4 : 8)>::type type; };
+
+inline std::size_t packed_size(std::size_t n, unsigned int n_bits) {
+	return (n * n_bits + 7) / 8;
+}
+
+/*
+ * packs n values, which must not have bits above NumBits, to p. returns the number of bytes written
+ */
+template<unsigned int NumBits, typename UintType>
+inline std::size_t pack_bits(const UintType* values, std::size_t n, byte_type* p) {
+	byte_type*      q        = p;
+	shift::uint64_t register_ = 0;
+	unsigned int    n_bits    = 0;
+	for (std::size_t i=0; i<n; ++i) {
+		const shift::uint64_t value  = values[i];
+		const unsigned int    n_free = 64 - n_bits;
+		if (NumBits < n_free) { // never taken for 64 bits, % 64 keeps the shift defined
+			register_ = (register_ << (NumBits % 64)) | value;
+			n_bits   += NumBits;
+			continue;
+		}
+		const unsigned int    n_rest = NumBits - n_free;
+		const shift::uint64_t word   = convert_byte_order<big_endian>(n_free == 64 ? value : (register_ << n_free) | (value >> n_rest));
+		std::memcpy(q, &word, 8);
+		q        += 8;
+		register_ = n_rest > 0 ? value & (~shift::uint64_t(0) >> (64 - n_rest)) : 0;
+		n_bits    = n_rest;
+	}
+	for (; n_bits >= 8; n_bits -= 8)
+		*q++ = static_cast<byte_type>(register_ >> (n_bits - 8));
+	if (n_bits > 0)
+		*q++ = static_cast<byte_type>(register_ << (8 - n_bits));
+	return q - p;
+}
+
+/*
+ * the 8 bytes from p as big endian word, bytes at or beyond end are 0
+ */
+inline shift::uint64_t load_bits(const byte_type* p, const byte_type* end) {
+	shift::uint64_t word = 0;
+	if (end - p >= 8) {
+		std::memcpy(&word, p, 8);
+		return convert_byte_order<big_endian>(word);
+	}
+	for (unsigned int i=0; p + i < end; ++i)
+		word |= static_cast<shift::uint64_t>(p[i]) << (56 - 8 * i);
+	return word;
+}
+
+/*
+ * the n_bits wide value at bit offset from p
+ */
+inline shift::uint64_t extract_bits(const byte_type* p, const byte_type* end, std::size_t offset, unsigned int n_bits) {
+	if (n_bits > 57)
+		return extract_bits(p, end, offset, n_bits - 32) << 32 | extract_bits(p, end, offset + n_bits - 32, 32);
+	return (load_bits(p + offset / 8, end) << (offset % 8)) >> (64 - n_bits);
+}
+
+#if defined __SSE4_1__
+
+/*
+ * shuffles and multipliers that move the bytes of 8 values of NumBits <= 16 into 4 byte lanes, the
+ * first bit of each value at the top after the multiplication
+ */
+struct bit_unpacking_masks {
+	byte_type       shuffle   [2][16];
+	shift::uint32_t multiplier[2][4];
+};
+
+template<unsigned int NumBits>
+inline const bit_unpacking_masks* build_bit_unpacking_masks() {
+	static bit_unpacking_masks masks;
+	for (unsigned int j=0; j<8; ++j) {
+		const unsigned int begin = j * NumBits / 8;
+		const unsigned int last  = (j * NumBits + NumBits - 1) / 8;
+		for (unsigned int k=0; k<4; ++k) {
+			const unsigned int index = begin + 3 - k;
+			masks.shuffle[j / 4][4 * (j % 4) + k] = static_cast<byte_type>(index <= last ? index : 0x80);
+		}
+		masks.multiplier[j / 4][j % 4] = 1u << (j * NumBits % 8);
+	}
+	return &masks;
+}
+
+template<unsigned int NumBits>
+inline const bit_unpacking_masks* bit_unpacking_masks_of() {
+	static const bit_unpacking_masks* masks = build_bit_unpacking_masks<NumBits>();
+	return masks;
+}
+
+template<unsigned int NumBits, bool Vectorized = (NumBits <= 16)>
+struct bit_unpacking_kernel {
+	template<typename UintType>
+	static std::size_t unpack(const byte_type*, const byte_type*, std::size_t, UintType*) { return 0; }
+};
+
+/*
+ * 8 values from NumBits bytes per step, as long as 16 bytes can be loaded
+ */
+template<unsigned int NumBits>
+struct bit_unpacking_kernel<NumBits, true> {
+	template<typename UintType>
+	static std::size_t unpack(const byte_type*, const byte_type*, std::size_t, UintType*) { return 0; }
+
+	static std::size_t unpack(const byte_type* p, const byte_type* end, std::size_t n, shift::uint32_t* values) {
+		const bit_unpacking_masks* masks = bit_unpacking_masks_of<NumBits>();
+		const __m128i shuffle_0    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks->shuffle[0]));
+		const __m128i shuffle_1    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks->shuffle[1]));
+		const __m128i multiplier_0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks->multiplier[0]));
+		const __m128i multiplier_1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks->multiplier[1]));
+		std::size_t i = 0;
+		for (; i + 8 <= n && end - p >= 16; i += 8, p += NumBits) {
+			const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			const __m128i v0   = _mm_mullo_epi32(_mm_shuffle_epi8(data, shuffle_0), multiplier_0);
+			const __m128i v1   = _mm_mullo_epi32(_mm_shuffle_epi8(data, shuffle_1), multiplier_1);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i    ), _mm_srli_epi32(v0, 32 - NumBits));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i + 4), _mm_srli_epi32(v1, 32 - NumBits));
+		}
+		return i;
+	}
+};
+
+#else
+
+template<unsigned int NumBits>
+struct bit_unpacking_kernel {
+	template<typename UintType>
+	static std::size_t unpack(const byte_type*, const byte_type*, std::size_t, UintType*) { return 0; }
+};
+
+#endif
+
+/*
+ * unpacks n values from p, the packed array ends at end
+ */
+template<unsigned int NumBits, typename UintType>
+inline void unpack_bits(const byte_type* p, const byte_type* end, std::size_t n, UintType* values) {
+	const std::size_t n_vectorized = bit_unpacking_kernel<NumBits>::unpack(p, end, n, values);
+	for (std::size_t i=n_vectorized; i<n; ++i)
+		values[i] = static_cast<UintType>(extract_bits(p, end, i * NumBits, NumBits));
+}
+
+/*
+ * kernels for widths that are only known at runtime, indexed by the width
+ */
+template<typename UintType>
+struct bit_packing_functions {
+	typedef std::size_t (*pack_function  )(const UintType*, std::size_t, byte_type*);
+	typedef void        (*unpack_function)(const byte_type*, const byte_type*, std::size_t, UintType*);
+	static const unsigned int max_bits = sizeof(UintType) * 8;
+	pack_function   pack  [max_bits + 1];
+	unpack_function unpack[max_bits + 1];
+};
+
+template<typename UintType, unsigned int NumBits>
+struct bit_packing_function_entries {
+	static void fill(bit_packing_functions<UintType>& functions) {
+		functions.pack  [NumBits] = &pack_bits  <NumBits, UintType>;
+		functions.unpack[NumBits] = &unpack_bits<NumBits, UintType>;
+		bit_packing_function_entries<UintType, NumBits - 1>::fill(functions);
+	}
+};
+
+template<typename UintType>
+struct bit_packing_function_entries<UintType, 0> {
+	static void fill(bit_packing_functions<UintType>&) {}
+};
+
+template<typename UintType>
+inline const bit_packing_functions<UintType>* build_bit_packing_functions() {
+	static bit_packing_functions<UintType> functions;
+	bit_packing_function_entries<UintType, bit_packing_functions<UintType>::max_bits>::fill(functions);
+	return &functions;
+}
+
+template<typename UintType>
+inline const bit_packing_functions<UintType>* bit_packing_functions_of() {
+	static const bit_packing_functions<UintType>* functions = build_bit_packing_functions<UintType>();
+	return functions;
+}
+
+/*
+ * as above for n_bits from 0 to the bits of UintType, 0 bit wide values take no bytes
+ */
+template<typename UintType>
+inline std::size_t pack_bits(const UintType* values, std::size_t n, unsigned int n_bits, byte_type* p) {
+	return n_bits == 0 ? 0 : bit_packing_functions_of<UintType>()->pack[n_bits](values, n, p);
+}
+
+template<typename UintType>
+inline void unpack_bits(const byte_type* p, const byte_type* end, std::size_t n, unsigned int n_bits, UintType* values) {
+	if (n_bits == 0)
+		std::fill(values, values + n, UintType(0));
+	else
+		bit_packing_functions_of<UintType>()->unpack[n_bits](p, end, n, values);
+}
+
+}} // shift::detail
+
+#endif /* SHIFT_DETAIL_BIT_PACKING_HPP_ */
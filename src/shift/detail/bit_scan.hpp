@@ -0,0 +1,57 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_DETAIL_BIT_SCAN_HPP_
+#define SHIFT_DETAIL_BIT_SCAN_HPP_
+
+#include <shift/types/cstdint.hpp>
+
+#if defined _MSC_VER
+	#include <intrin.h>
+#endif
+
+namespace shift {
+namespace detail {
+
+/*
+ * number of significant bits of v, 0 for 0
+ */
+inline unsigned int significant_bits(shift::uint64_t v) {
+	if (v == 0)
+		return 0;
+#if defined __GNUC__
+	return 64 - __builtin_clzll(v);
+#elif defined _MSC_VER && defined _M_X64
+	unsigned long index;
+	_BitScanReverse64(&index, v);
+	return index + 1;
+#else
+	unsigned int n = 0;
+	for (; v != 0; v >>= 1) ++n;
+	return n;
+#endif
+}
+
+/*
+ * index of the lowest set bit of v, v must not be 0
+ */
+inline unsigned int trailing_zeros(shift::uint64_t v) {
+#if defined __GNUC__
+	return __builtin_ctzll(v);
+#elif defined _MSC_VER && defined _M_X64
+	unsigned long index;
+	_BitScanForward64(&index, v);
+	return index;
+#else
+	unsigned int n = 0;
+	for (; (v & 1) == 0; v >>= 1) ++n;
+	return n;
+#endif
+}
+
+}} // shift::detail
+
+#endif /* SHIFT_DETAIL_BIT_SCAN_HPP_ */
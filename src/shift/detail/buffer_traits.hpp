@@ -0,0 +1,24 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_DETAIL_BUFFER_TRAITS_HPP_
+#define SHIFT_DETAIL_BUFFER_TRAITS_HPP_
+
+namespace shift {
+
+class counting_buffer;
+
+namespace detail {
+
+/*
+ * buffers that only count the bytes written to them, so encoders can skip producing the bytes
+ */
+template<typename BufferType> struct is_counting_buffer                  { static const bool value = false; };
+template<>                    struct is_counting_buffer<counting_buffer> { static const bool value = true;  };
+
+}} // shift::detail
+
+#endif /* SHIFT_DETAIL_BUFFER_TRAITS_HPP_ */
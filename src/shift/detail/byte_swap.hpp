@@ -0,0 +1,143 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_DETAIL_BYTE_SWAP_HPP_
+#define SHIFT_DETAIL_BYTE_SWAP_HPP_
+
+#include <cstring>
+#include <cstddef>
+
+#include <shift/types/byte.hpp>
+#include <shift/types/cstdint.hpp>
+#include <shift/detail/endianness.hpp>
+#include <shift/detail/endian_reversal.hpp>
+
+#if defined __SSSE3__ || defined __AVX2__
+	#include <immintrin.h>
+#endif
+
+namespace shift {
+namespace detail {
+
+/*
+ * byte order reversal of arrays. swap_lanes<Size> reverses the bytes of each Size byte value,
+ * reverse_block reverses a whole block. pshufb is used when SSSE3 or AVX2 are enabled at compile
+ * time (e.g. -mssse3, -mavx2 or -march=native), the remainder is handled by the scalar byte swaps.
+ * source and destination may be unaligned but must not overlap.
+ */
+
+#if defined __SSSE3__ || defined __AVX2__
+
+template<std::size_t Size> struct lane_shuffle;
+template<> struct lane_shuffle<2 > { static __m128i mask() { return _mm_set_epi8(14, 15, 12, 13, 10, 11,  8,  9,  6,  7,  4,  5,  2,  3,  0,  1); } };
+template<> struct lane_shuffle<4 > { static __m128i mask() { return _mm_set_epi8(12, 13, 14, 15,  8,  9, 10, 11,  4,  5,  6,  7,  0,  1,  2,  3); } };
+template<> struct lane_shuffle<8 > { static __m128i mask() { return _mm_set_epi8( 8,  9, 10, 11, 12, 13, 14, 15,  0,  1,  2,  3,  4,  5,  6,  7); } };
+template<> struct lane_shuffle<16> { static __m128i mask() { return _mm_set_epi8( 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15); } };
+
+/*
+ * shuffles [0, n_bytes) in blocks of 32 or 16 bytes, returns the number of bytes processed
+ */
+template<std::size_t Size>
+inline std::size_t shuffle_blocks(const byte_type* source, std::size_t n_bytes, byte_type* destination) {
+	const __m128i mask = lane_shuffle<Size>::mask();
+	std::size_t i = 0;
+#if defined __AVX2__
+	const __m256i wide_mask = _mm256_inserti128_si256(_mm256_castsi128_si256(mask), mask, 1);
+	for (; i + 32 <= n_bytes; i += 32) {
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_shuffle_epi8(v, wide_mask));
+	}
+#endif
+	for (; i + 16 <= n_bytes; i += 16) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_shuffle_epi8(v, mask));
+	}
+	return i;
+}
+
+#else
+
+template<std::size_t Size>
+inline std::size_t shuffle_blocks(const byte_type*, std::size_t, byte_type*) {
+	return 0;
+}
+
+#endif
+
+template<std::size_t Size>
+inline void swap_lanes(const byte_type* source, std::size_t n_values, byte_type* destination) {
+	typedef typename uint_of_size<Size>::type uint_type;
+	const std::size_t n_bytes = n_values * Size;
+	for (std::size_t i = shuffle_blocks<Size>(source, n_bytes, destination); i < n_bytes; i += Size) {
+		uint_type v;
+		std::memcpy(&v, source + i, Size);
+		v = endian_reverse(v);
+		std::memcpy(destination + i, &v, Size);
+	}
+}
+
+template<>
+inline void swap_lanes<1>(const byte_type* source, std::size_t n_values, byte_type* destination) {
+	std::memcpy(destination, source, n_values);
+}
+
+inline void reverse_block(const byte_type* source, std::size_t n_bytes, byte_type* destination) {
+	std::size_t i = 0;
+#if defined __SSSE3__ || defined __AVX2__
+	const __m128i mask = lane_shuffle<16>::mask();
+	for (; i + 16 <= n_bytes; i += 16) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + n_bytes - i - 16));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_shuffle_epi8(v, mask));
+	}
+#endif
+	for (; i < n_bytes; ++i)
+		destination[i] = source[n_bytes - i - 1];
+}
+
+/*
+ * conversion of arrays between values in the system byte order and their representation in a given
+ * byte order; the representation does not need to be aligned
+ */
+template<bool ReverseBytes>
+struct array_byte_order_conversion;
+
+template<>
+struct array_byte_order_conversion<false> {
+	template<typename T>
+	static void encode(const T* values, std::size_t n, byte_type* p) {
+		std::memcpy(p, values, n * sizeof(T));
+	}
+	template<typename T>
+	static void decode(const byte_type* p, std::size_t n, T* values) {
+		std::memcpy(values, p, n * sizeof(T));
+	}
+};
+
+template<>
+struct array_byte_order_conversion<true> {
+	template<typename T>
+	static void encode(const T* values, std::size_t n, byte_type* p) {
+		swap_lanes<sizeof(T)>(reinterpret_cast<const byte_type*>(values), n, p);
+	}
+	template<typename T>
+	static void decode(const byte_type* p, std::size_t n, T* values) {
+		swap_lanes<sizeof(T)>(p, n, reinterpret_cast<byte_type*>(values));
+	}
+};
+
+template<endianness Endianness, typename T>
+inline void encode_values(const T* values, std::size_t n, byte_type* p) {
+	array_byte_order_conversion<requires_endianness_conversion<Endianness>::value>::encode(values, n, p);
+}
+
+template<endianness Endianness, typename T>
+inline void decode_values(const byte_type* p, std::size_t n, T* values) {
+	array_byte_order_conversion<requires_endianness_conversion<Endianness>::value>::decode(p, n, values);
+}
+
+}} // shift::detail
+
+#endif /* SHIFT_DETAIL_BYTE_SWAP_HPP_ */
@@ -0,0 +1,132 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_DETAIL_DELTA_CODING_HPP_
+#define SHIFT_DETAIL_DELTA_CODING_HPP_
+
+#include <cstddef>
+
+#include <shift/types/cstdint.hpp>
+#include <shift/detail/endian_reversal.hpp>
+#include <shift/detail/zig_zag_coding.hpp>
+
+#if defined __SSE2__
+	#include <emmintrin.h>
+#endif
+
+namespace shift {
+namespace detail {
+
+/*
+ * delta coding of integer sequences: the residuals of order 1 are the differences to the previous
+ * value, those of order 2 the differences of these differences; the value and the difference before
+ * the first element are 0. residuals are computed modulo 2^bits and zig zag encoded, so small
+ * negative differences stay small.
+ */
+
+template<std::size_t NBytes> struct int_of_size;
+template<> struct int_of_size<1> { typedef shift::int8_t  type; };
+template<> struct int_of_size<2> { typedef shift::int16_t type; };
+template<> struct int_of_size<4> { typedef shift::int32_t type; };
+template<> struct int_of_size<8> { typedef shift::int64_t type; };
+
+/*
+ * the last value and difference of the elements converted so far
+ */
+template<typename UintType>
+struct delta_state {
+	delta_state() : value(0), delta(0) {}
+	UintType value;
+	UintType delta;
+};
+
+template<unsigned int Order, typename UintType>
+inline void encode_deltas(const UintType* values, std::size_t n, delta_state<UintType>& state, UintType* residuals) {
+	typedef typename int_of_size<sizeof(UintType)>::type int_type;
+	for (std::size_t i=0; i<n; ++i) {
+		const UintType delta = static_cast<UintType>(values[i] - state.value);
+		UintType residual = delta;
+		if (Order == 2)
+			residual = static_cast<UintType>(delta - state.delta);
+		state.value = values[i];
+		state.delta = delta;
+		residuals[i] = zig_zag_encode<UintType>(static_cast<int_type>(residual));
+	}
+}
+
+/*
+ * running sums of n values in place, starting with sum. pairs of 8 byte and quadruples of 4 byte
+ * values are summed with SSE2 when it is enabled
+ */
+template<std::size_t Size>
+struct prefix_sum_kernel {
+	template<typename UintType>
+	static std::size_t sum(UintType*, std::size_t, UintType&) { return 0; }
+};
+
+#if defined __SSE2__
+
+template<>
+struct prefix_sum_kernel<4> {
+	template<typename UintType>
+	static std::size_t sum(UintType* values, std::size_t n, UintType& sum) {
+		__m128i carry = _mm_set1_epi32(static_cast<int>(sum));
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+			v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+			v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+			v = _mm_add_epi32(v, carry);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), v);
+			carry = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3));
+		}
+		if (i > 0) sum = values[i - 1];
+		return i;
+	}
+};
+
+template<>
+struct prefix_sum_kernel<8> {
+	template<typename UintType>
+	static std::size_t sum(UintType* values, std::size_t n, UintType& sum) {
+		__m128i carry = _mm_set1_epi64x(static_cast<long long>(sum));
+		std::size_t i = 0;
+		for (; i + 2 <= n; i += 2) {
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+			v = _mm_add_epi64(v, _mm_slli_si128(v, 8));
+			v = _mm_add_epi64(v, carry);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), v);
+			carry = _mm_unpackhi_epi64(v, v);
+		}
+		if (i > 0) sum = values[i - 1];
+		return i;
+	}
+};
+
+#endif
+
+template<typename UintType>
+inline void prefix_sum(UintType* values, std::size_t n, UintType& sum) {
+	for (std::size_t i = prefix_sum_kernel<sizeof(UintType)>::sum(values, n, sum); i < n; ++i)
+		values[i] = sum = static_cast<UintType>(sum + values[i]);
+}
+
+/*
+ * converts the residuals back to the values in place
+ */
+template<unsigned int Order, typename UintType>
+inline void decode_deltas(UintType* residuals, std::size_t n, delta_state<UintType>& state) {
+	typedef typename int_of_size<sizeof(UintType)>::type int_type;
+	for (std::size_t i=0; i<n; ++i)
+		residuals[i] = static_cast<UintType>(zig_zag_decode<int_type>(residuals[i]));
+	if (Order == 2)
+		prefix_sum(residuals, n, state.delta);
+	prefix_sum(residuals, n, state.value);
+}
+
+}} // shift::detail
+
+#endif /* SHIFT_DETAIL_DELTA_CODING_HPP_ */
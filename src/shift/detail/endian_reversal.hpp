@@ -7,7 +7,17 @@
 #ifndef SHIFT_DETAIL_ENDIAN_REVERSAL_HPP_
 #define SHIFT_DETAIL_ENDIAN_REVERSAL_HPP_
 
+#include <cstring>
+#include <cstddef>
+
 #include <shift/types/cstdint.hpp>
+#include <shift/detail/endianness.hpp>
+#include <shift/detail/static_assert.hpp>
+#include <shift/detail/type_traits.hpp>
+
+#if defined _MSC_VER
+	#include <stdlib.h>
+#endif
 
 namespace shift {
 namespace detail {
@@ -21,23 +31,91 @@ inline shift::uint8_t endian_reverse(shift::uint8_t v) {
 // uint16
 
 inline shift::uint16_t endian_reverse(shift::uint16_t v) {
+#if defined __GNUC__ && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+	return __builtin_bswap16(v);
+#elif defined _MSC_VER
+	return _byteswap_ushort(v);
+#else
 	return (v >> 8) | (v << 8);
+#endif
 }
 
 // uint32
 
 inline shift::uint32_t endian_reverse(shift::uint32_t v) {
+#if defined __GNUC__
+	return __builtin_bswap32(v);
+#elif defined _MSC_VER
+	return _byteswap_ulong(v);
+#else
 	return  v               << 24 |  v               >> 24 |
 	       (v & 0x0000FF00) << 8  | (v & 0x00FF0000) >> 8;
+#endif
 }
 
 // uint64
 
 inline shift::uint64_t endian_reverse(shift::uint64_t v) {
+#if defined __GNUC__
+	return __builtin_bswap64(v);
+#elif defined _MSC_VER
+	return _byteswap_uint64(v);
+#else
 	return  v                          << 56 |  v                          >> 56 |
 	       (v & 0x000000000000FF00ULL) << 40 | (v & 0x00FF000000000000ULL) >> 40 |
 	       (v & 0x0000000000FF0000ULL) << 24 | (v & 0x0000FF0000000000ULL) >> 24 |
 	       (v & 0x00000000FF000000ULL) << 8  | (v & 0x000000FF00000000ULL) >> 8;
+#endif
+}
+
+// integral types not covered above, e.g. unsigned long long where uint64_t is unsigned long;
+// floating point values have to go through reverse_bytes
+
+template<std::size_t NBytes> struct uint_of_size;
+template<> struct uint_of_size<1> { typedef shift::uint8_t  type; };
+template<> struct uint_of_size<2> { typedef shift::uint16_t type; };
+template<> struct uint_of_size<4> { typedef shift::uint32_t type; };
+template<> struct uint_of_size<8> { typedef shift::uint64_t type; };
+
+template<typename IntType>
+inline IntType endian_reverse(IntType v) {
+	SHIFT_STATIC_ASSERT(is_integral<IntType>::value, endian_reverse_requires_an_integral_type);
+	typedef typename uint_of_size<sizeof(IntType)>::type uint_type;
+	return static_cast<IntType>(endian_reverse(static_cast<uint_type>(v)));
+}
+
+/*
+ * reverses the byte order of any trivially copyable value of 1, 2, 4 or 8 bytes, e.g. float and double
+ */
+template<typename T>
+inline T reverse_bytes(T value) {
+	typedef typename uint_of_size<sizeof(T)>::type uint_type;
+	uint_type tmp;
+	std::memcpy(&tmp, &value, sizeof(T));
+	tmp = endian_reverse(tmp);
+	std::memcpy(&value, &tmp, sizeof(T));
+	return value;
+}
+
+template<bool ReverseBytes>
+struct byte_order_conversion;
+
+template<>
+struct byte_order_conversion<false> {
+	template<typename T> static T convert(T value) { return value; }
+};
+
+template<>
+struct byte_order_conversion<true> {
+	template<typename T> static T convert(T value) { return reverse_bytes(value); }
+};
+
+/*
+ * conversion between the system byte order and a given byte order
+ */
+template<endianness Endianness, typename T>
+inline T convert_byte_order(T value) {
+	return byte_order_conversion<requires_endianness_conversion<Endianness>::value>::convert(value);
 }
 
 }} // shift::detail
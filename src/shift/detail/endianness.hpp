@@ -7,41 +7,40 @@
 #ifndef SHIFT_DETAIL_ENDIANNESS_HPP_
 #define SHIFT_DETAIL_ENDIANNESS_HPP_
 
-#include <shift/types/cstdint.hpp>
 #include <shift/concepts/endianness.hpp>
+#include <shift/detail/static_assert.hpp>
+
+/*
+ * the byte order of the target is taken from the compiler, it can be provided by defining
+ * SHIFT_SYSTEM_ENDIANNESS as shift::little_endian or shift::big_endian for other compilers.
+ */
+#if !defined SHIFT_SYSTEM_ENDIANNESS
+	#if defined __BYTE_ORDER__ && defined __ORDER_LITTLE_ENDIAN__ && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		#define SHIFT_SYSTEM_ENDIANNESS shift::little_endian
+	#elif defined __BYTE_ORDER__ && defined __ORDER_BIG_ENDIAN__ && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		#define SHIFT_SYSTEM_ENDIANNESS shift::big_endian
+	#elif defined _MSC_VER
+		#define SHIFT_SYSTEM_ENDIANNESS shift::little_endian
+	#endif
+#endif
 
 namespace shift { namespace detail {
 
-struct endianness_impl {
+#if defined SHIFT_SYSTEM_ENDIANNESS
+	static const endianness system_endianness = SHIFT_SYSTEM_ENDIANNESS;
+#else
+	SHIFT_STATIC_ASSERT(false, could_not_determine_the_system_endianness_please_define_SHIFT_SYSTEM_ENDIANNESS);
+#endif
+
+template<endianness EncodingEndianness>
+struct requires_endianness_conversion {
+	static const bool value = EncodingEndianness != system_endianness;
+};
 
-	static bool is_little_endian() {
-		static const bool is_little_endian_ = is_little_endian_impl();
-		return is_little_endian_;
-	}
-
-	static bool is_big_endian() {
-		static const bool is_big_endian_ = is_big_endian_impl();
-		return is_big_endian_;
-	}
-
-	static endianness system_endianness() {
-		static const endianness sys_endianness = is_little_endian() ? little_endian : big_endian;
-		return sys_endianness;
-	}
-
-private:
-
-	static bool is_little_endian_impl() {
-		uint16_t v = 256;
-		uint8_t* p = reinterpret_cast<uint8_t*>(&v);
-		return p[1] == 1;
-	}
-
-	static bool is_big_endian_impl() {
-		uint16_t v = 1;
-		uint8_t* p = reinterpret_cast<uint8_t*>(&v);
-		return p[1] == 1;
-	}
+struct endianness_impl {
+	static bool       is_little_endian()  { return detail::system_endianness == little_endian; }
+	static bool       is_big_endian()     { return detail::system_endianness == big_endian;    }
+	static endianness system_endianness() { return detail::system_endianness;                  }
 };
 
 }} // shift::detail
@@ -0,0 +1,145 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_DETAIL_FRAME_OF_REFERENCE_HPP_
+#define SHIFT_DETAIL_FRAME_OF_REFERENCE_HPP_
+
+#include <cstddef>
+
+#include <shift/exception.hpp>
+#include <shift/types/byte.hpp>
+#include <shift/types/cstdint.hpp>
+#include <shift/detail/bit_scan.hpp>
+#include <shift/detail/var_int.hpp>
+#include <shift/detail/var_uint.hpp>
+#include <shift/detail/bit_packing.hpp>
+#include <shift/detail/endian_reversal.hpp>
+#include <shift/detail/stream_operator_interface.hpp>
+
+namespace shift {
+namespace detail {
+
+/*
+ * frame of reference coding of integer sequences in blocks of frame_of_reference_block_size values:
+ * the minimum of a block as var int, the width of the offsets to it as one byte and the offsets
+ * packed to this width. with patching, offsets that are wider than the width are exceptions: their
+ * number follows the width, then for each exception its index in the block as one byte and its bits
+ * above the width as var uint; the packed offsets keep the bits within the width.
+ */
+static const std::size_t frame_of_reference_block_size = bit_packing_block_size;
+
+template<typename IntType>
+struct frame_of_reference_block {
+	typedef typename uint_of_size<sizeof(IntType)>::type                 unsigned_type;
+	typedef typename uint_of_size<(sizeof(IntType) <= 4 ? 4 : 8)>::type  uint_type;
+	typedef typename var_int_value<IntType>::uint_type                   reference_type;
+
+	static const unsigned int max_bits = sizeof(IntType) * 8;
+	static const std::size_t  max_size = max_var_uint_size<reference_type>::value + 2
+	                                   + frame_of_reference_block_size * (1 + max_var_uint_size<uint_type>::value)
+	                                   + frame_of_reference_block_size * sizeof(IntType);
+
+	/*
+	 * writes the block of n values to p, returns the number of bytes written
+	 */
+	static std::size_t encode(const IntType* values, std::size_t n, bool patched, byte_type* p) {
+		byte_type* begin = p;
+		IntType    min   = values[0];
+		for (std::size_t i=1; i<n; ++i)
+			if (values[i] < min) min = values[i];
+
+		uint_type    offsets[frame_of_reference_block_size];
+		unsigned int counts [max_bits + 1] = {};
+		for (std::size_t i=0; i<n; ++i) {
+			offsets[i] = static_cast<unsigned_type>(static_cast<unsigned_type>(values[i]) - static_cast<unsigned_type>(min));
+			++counts[significant_bits(offsets[i])];
+		}
+		unsigned int max_width = max_bits;
+		while (max_width > 0 && counts[max_width] == 0) --max_width;
+		const unsigned int width = patched ? patched_width(counts, max_width, n) : max_width;
+
+		p    = encode_var_uint(var_int_value<IntType>::encode(min), p);
+		*p++ = static_cast<byte_type>(width);
+		if (patched) {
+			byte_type* n_exceptions = p++;
+			*n_exceptions = 0;
+			for (std::size_t i=0; i<n && width < max_width; ++i) {
+				if (significant_bits(offsets[i]) <= width)
+					continue;
+				*p++ = static_cast<byte_type>(i);
+				p    = encode_var_uint(static_cast<uint_type>(offsets[i] >> width), p);
+				offsets[i] &= ~(~uint_type(0) << width);
+				++*n_exceptions;
+			}
+		}
+		return p - begin + pack_bits(offsets, n, width, p);
+	}
+
+	/*
+	 * reads a block of n values from the source, throws out_of_range for widths and exceptions that do
+	 * not fit the block
+	 */
+	template<typename SourceType>
+	static void decode(SourceType& source, IntType* values, std::size_t n, bool patched) {
+		typedef istream_operator_interface<SourceType> interface_type;
+
+		reference_type reference;
+		read_var_uint_bytes(source, reference, max_var_uint_size<reference_type>::value);
+		const unsigned_type min   = static_cast<unsigned_type>(var_int_value<IntType>::decode(reference));
+		const unsigned int  width = interface_type::get(source);
+		if (width > max_bits)
+			SHIFT_THROW(out_of_range(width, 0, max_bits + 1));
+
+		byte_type    indices[frame_of_reference_block_size];
+		uint_type    highs  [frame_of_reference_block_size];
+		unsigned int n_exceptions = 0;
+		if (patched) {
+			n_exceptions = interface_type::get(source);
+			if (n_exceptions > (width < max_bits ? n : 0))
+				SHIFT_THROW(out_of_range(n_exceptions, 0, (width < max_bits ? n : 0) + 1));
+			for (unsigned int k=0; k<n_exceptions; ++k) {
+				indices[k] = interface_type::get(source);
+				if (indices[k] >= n)
+					SHIFT_THROW(out_of_range(indices[k], 0, n));
+				read_var_uint_bytes(source, highs[k], max_var_uint_size<uint_type>::value);
+			}
+		}
+
+		const std::size_t n_bytes = packed_size(n, width);
+		const byte_type*  data    = interface_type::get_array(source, n_bytes).first;
+		uint_type offsets[frame_of_reference_block_size];
+		unpack_bits(data, data + n_bytes, n, width, offsets);
+		for (unsigned int k=0; k<n_exceptions; ++k)
+			offsets[indices[k]] |= highs[k] << width;
+		for (std::size_t i=0; i<n; ++i)
+			values[i] = static_cast<IntType>(static_cast<unsigned_type>(min + offsets[i]));
+	}
+
+private:
+
+	/*
+	 * the width with the smallest block, counting an exception as its index and the var uint of the
+	 * bits above the width of the widest offset
+	 */
+	static unsigned int patched_width(const unsigned int* counts, unsigned int max_width, std::size_t n) {
+		std::size_t  best_size    = n * max_width;
+		unsigned int best_width   = max_width;
+		std::size_t  n_exceptions = 0;
+		for (unsigned int width = max_width; width-- > 0; ) {
+			n_exceptions += counts[width + 1];
+			const std::size_t size = n * width + n_exceptions * (8 + 8 * ((max_width - width + 6) / 7));
+			if (size < best_size) {
+				best_size  = size;
+				best_width = width;
+			}
+		}
+		return best_width;
+	}
+};
+
+}} // shift::detail
+
+#endif /* SHIFT_DETAIL_FRAME_OF_REFERENCE_HPP_ */
@@ -0,0 +1,164 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_DETAIL_RECORD_WORDS_HPP_
+#define SHIFT_DETAIL_RECORD_WORDS_HPP_
+
+#include <cstring>
+#include <cstddef>
+
+#include <shift/types/byte.hpp>
+#include <shift/types/cstdint.hpp>
+#include <shift/types/fixed_width_uint.hpp>
+#include <shift/detail/bit_mask.hpp>
+#include <shift/detail/endianness.hpp>
+#include <shift/detail/endian_reversal.hpp>
+#include <shift/detail/type_traits.hpp>
+
+#if defined __BMI2__ && defined __x86_64__
+	#include <immintrin.h>
+#endif
+
+namespace shift {
+namespace detail {
+
+/*
+ * records of up to 16 bytes held in one or two 64 bit words, the first byte of the record is the
+ * most significant byte of the first word. bit i of the record, counted from bit 7 of byte 0, is
+ * bit 63 - i % 64 of word i / 64, so a field is a run of bits of one word or of two adjacent words
+ */
+static const std::size_t max_record_words_size = 16;
+
+template<std::size_t Size>
+struct record_words {
+	static const std::size_t n_words = (Size + 7) / 8;
+
+	shift::uint64_t words[n_words];
+
+	void load(const byte_type* p) {
+		byte_type bytes[8 * n_words] = {};
+		std::memcpy(bytes, p, Size);
+		for (std::size_t i=0; i<n_words; ++i) {
+			std::memcpy(words + i, bytes + 8 * i, 8);
+			words[i] = convert_byte_order<big_endian>(words[i]);
+		}
+	}
+
+	void store(byte_type* p) const {
+		byte_type bytes[8 * n_words];
+		for (std::size_t i=0; i<n_words; ++i) {
+			const shift::uint64_t word = convert_byte_order<big_endian>(words[i]);
+			std::memcpy(bytes + 8 * i, &word, 8);
+		}
+		std::memcpy(p, bytes, Size);
+	}
+};
+
+/*
+ * the NBits bits beginning at bit FirstBit of the record as a right aligned value. the shifts and
+ * masks are constants, with BMI2 they are pext and pdep with a constant mask
+ */
+#if defined __BMI2__ && defined __x86_64__
+inline shift::uint64_t extract_word_bits(shift::uint64_t word, shift::uint64_t mask, unsigned int  ) { return _pext_u64(word , mask); }
+inline shift::uint64_t deposit_word_bits(shift::uint64_t bits, shift::uint64_t mask, unsigned int  ) { return _pdep_u64(bits , mask); }
+#else
+inline shift::uint64_t extract_word_bits(shift::uint64_t word, shift::uint64_t mask, unsigned int shift_) { return (word & mask) >> shift_; }
+inline shift::uint64_t deposit_word_bits(shift::uint64_t bits, shift::uint64_t mask, unsigned int shift_) { return (bits << shift_) & mask; }
+#endif
+
+template<unsigned int FirstBit, unsigned int NBits, bool Straddles = (FirstBit / 64 != (FirstBit + NBits - 1) / 64)>
+struct record_bits;
+
+template<unsigned int FirstBit, unsigned int NBits>
+struct record_bits<FirstBit, NBits, false> {
+	static const unsigned int    word   = FirstBit / 64;
+	static const unsigned int    offset = 64 - (FirstBit % 64) - NBits;
+	static const shift::uint64_t mask   = bit_mask_all_bits<NBits, shift::uint64_t>::value << offset;
+
+	static shift::uint64_t get(const shift::uint64_t* words) {
+		return extract_word_bits(words[word], mask, offset);
+	}
+
+	static void put(shift::uint64_t* words, shift::uint64_t bits) {
+		words[word] |= deposit_word_bits(bits, mask, offset);
+	}
+};
+
+template<unsigned int FirstBit, unsigned int NBits>
+struct record_bits<FirstBit, NBits, true> {
+	static const unsigned int n_high = 64 - FirstBit % 64;
+	static const unsigned int n_low  = NBits - n_high;
+
+	typedef record_bits<FirstBit         , n_high, false> high_type;
+	typedef record_bits<FirstBit + n_high, n_low , false> low_type;
+
+	static shift::uint64_t get(const shift::uint64_t* words) {
+		return high_type::get(words) << n_low | low_type::get(words);
+	}
+
+	static void put(shift::uint64_t* words, shift::uint64_t bits) {
+		high_type::put(words, bits >> n_low);
+		low_type ::put(words, bits & bit_mask_all_bits<n_low, shift::uint64_t>::value);
+	}
+};
+
+/*
+ * the bits of field values as they are placed into the record for EncodingEndianness: arithmetic
+ * types are stored in the byte order of the encoding, fixed_width_uints and bools like the bit
+ * writer and reader store them
+ */
+template<typename T>
+struct record_value {
+	static const bool fits = has_plain_encoding<T>::value && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+	template<endianness EncodingEndianness>
+	static shift::uint64_t to_bits(const T& value) {
+		typedef typename uint_of_size<sizeof(T)>::type uint_type;
+		uint_type bits;
+		std::memcpy(&bits, &value, sizeof(T));
+		return EncodingEndianness == little_endian ? endian_reverse(bits) : bits;
+	}
+
+	template<endianness EncodingEndianness>
+	static void from_bits(shift::uint64_t bits, T& value) {
+		typedef typename uint_of_size<sizeof(T)>::type uint_type;
+		uint_type v = static_cast<uint_type>(bits);
+		v = EncodingEndianness == little_endian ? endian_reverse(v) : v;
+		std::memcpy(&value, &v, sizeof(T));
+	}
+};
+
+template<>
+struct record_value<bool> {
+	static const bool fits = true;
+
+	template<endianness EncodingEndianness>
+	static shift::uint64_t to_bits(bool value) { return value ? 1 : 0; }
+
+	template<endianness EncodingEndianness>
+	static void from_bits(shift::uint64_t bits, bool& value) { value = bits != 0; }
+};
+
+template<typename IntType, unsigned int NumBits>
+struct record_value<fixed_width_uint<IntType, NumBits> > {
+	static const bool fits = true;
+
+	template<endianness EncodingEndianness>
+	static shift::uint64_t to_bits(const fixed_width_uint<IntType, NumBits>& value) {
+		const IntType v = requires_endianness_conversion<EncodingEndianness>::value ? endian_reverse(*value) : *value;
+		return static_cast<shift::uint64_t>(v) & bit_mask_all_bits<NumBits, shift::uint64_t>::value;
+	}
+
+	template<endianness EncodingEndianness>
+	static void from_bits(shift::uint64_t bits, fixed_width_uint<IntType, NumBits>& value) {
+		const IntType v = static_cast<IntType>(bits);
+		value = requires_endianness_conversion<EncodingEndianness>::value ? endian_reverse(v) : v;
+	}
+};
+
+}} // shift::detail
+
+#endif /* SHIFT_DETAIL_RECORD_WORDS_HPP_ */
@@ -31,6 +31,24 @@ struct size_encoder<variable_length> {
 	}
 };
 
+template<>
+struct size_encoder<stream_vbyte> : size_encoder<variable_length> {};
+
+template<>
+struct size_encoder<delta_coding> : size_encoder<variable_length> {};
+
+template<>
+struct size_encoder<delta_of_delta_coding> : size_encoder<variable_length> {};
+
+template<>
+struct size_encoder<bit_packed> : size_encoder<variable_length> {};
+
+template<>
+struct size_encoder<frame_of_reference> : size_encoder<variable_length> {};
+
+template<>
+struct size_encoder<patched_frame_of_reference> : size_encoder<variable_length> {};
+
 template<>
 struct size_encoder<no_size_field> {
 	template<typename SinkType>
@@ -61,6 +79,24 @@ struct size_decoder<variable_length> {
 	}
 };
 
+template<>
+struct size_decoder<stream_vbyte> : size_decoder<variable_length> {};
+
+template<>
+struct size_decoder<delta_coding> : size_decoder<variable_length> {};
+
+template<>
+struct size_decoder<delta_of_delta_coding> : size_decoder<variable_length> {};
+
+template<>
+struct size_decoder<bit_packed> : size_decoder<variable_length> {};
+
+template<>
+struct size_decoder<frame_of_reference> : size_decoder<variable_length> {};
+
+template<>
+struct size_decoder<patched_frame_of_reference> : size_decoder<variable_length> {};
+
 }} // shift::detail
 
 #endif /* SHIFT_DETAIL_SIZE_ENCODING_HPP_ */
@@ -51,10 +51,46 @@ struct ostream_operator_interface {
 		return sink;
 	}
 
+	template<typename T>
+	inline static sink_type& write_value(sink_type& sink, const T value) {
+		sink.write_value(value);
+		return sink;
+	}
+
+	template<typename T>
+	inline static sink_type& write_values(sink_type& sink, const T* values, const std::size_t n) {
+		sink.write_values(values, n);
+		return sink;
+	}
+
 	inline static sink_type& write_array(sink_type& sink, const byte_type* p, const std::size_t n) {
 		sink.write_array(p, n);
 		return sink;
 	}
+
+	inline static const buffer_position& get_position(const sink_type& sink) {
+		return sink.current_position_;
+	}
+
+	inline static byte_type read(sink_type& sink, const std::size_t index) {
+		return sink.read(index);
+	}
+
+	inline static byte_type* reserve(sink_type& sink, const std::size_t n_bytes) {
+		return sink.reserve(n_bytes);
+	}
+
+	inline static void set_position(sink_type& sink, const buffer_position& position) {
+		sink.set_position(position);
+	}
+
+	inline static void set_size(sink_type& sink, const std::size_t size) {
+		sink.set_size(size);
+	}
+
+	inline static typename sink_type::buffer_type& get_buffer(sink_type& sink) {
+		return sink.buffer_;
+	}
 };
 
 template<typename SourceType>
@@ -75,13 +111,38 @@ struct istream_operator_interface {
 		source.get(value);
 	}
 
-	inline static void get_block(source_type& source, byte_type* data, unsigned int n_bytes) {
+	inline static void get_block(source_type& source, byte_type* data, std::size_t n_bytes) {
 		source.get_block(data, n_bytes);
 	}
 
-	inline static std::pair<const byte_type*, const byte_type*> get_array(source_type& source, unsigned int n_bytes) {
+	template<typename T>
+	inline static void get_value(source_type& source, T& value) {
+		source.get_value(value);
+	}
+
+	inline static std::pair<const byte_type*, const byte_type*> get_array(source_type& source, std::size_t n_bytes) {
 		return source.get_array(n_bytes);
 	}
+
+	inline static const buffer_position& get_position(const source_type& source) {
+		return source.current_position_;
+	}
+
+	inline static void set_position(source_type& source, const buffer_position& position) {
+		source.set_position(position);
+	}
+
+	inline static std::size_t request(source_type& source, const std::size_t index, const std::size_t n) {
+		return source.request(index, n);
+	}
+
+	inline static std::size_t available(const source_type& source, const std::size_t index) {
+		return source.available(index);
+	}
+
+	inline static const byte_type* location(const source_type& source, const std::size_t index) {
+		return source.location(index);
+	}
 };
 
 } } // shift::detail
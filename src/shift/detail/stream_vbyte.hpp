@@ -0,0 +1,149 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_DETAIL_STREAM_VBYTE_HPP_
+#define SHIFT_DETAIL_STREAM_VBYTE_HPP_
+
+#include <cstring>
+#include <cstddef>
+
+#include <shift/types/byte.hpp>
+#include <shift/types/cstdint.hpp>
+#include <shift/detail/endianness.hpp>
+#include <shift/detail/endian_reversal.hpp>
+
+#if defined __SSSE3__ || defined __AVX2__
+	#include <immintrin.h>
+#endif
+
+namespace shift {
+namespace detail {
+
+/*
+ * stream vbyte: n integers of up to 4 bytes are stored as (n + 3) / 4 control bytes followed by
+ * the data bytes. each control byte holds the 2 bit codes of 4 values, the first value in the
+ * lowest bits; a value has code + 1 data bytes in little endian order. unused codes are 0.
+ */
+
+inline std::size_t stream_vbyte_control_size(std::size_t n) {
+	return (n + 3) / 4;
+}
+
+inline unsigned int stream_vbyte_code(shift::uint32_t v) {
+	return v < (1u << 8) ? 0 : v < (1u << 16) ? 1 : v < (1u << 24) ? 2 : 3;
+}
+
+/*
+ * the number of data bytes of each control byte and, with SSSE3 or AVX2, the shuffle that moves
+ * them into 4 lanes of 4 bytes
+ */
+struct stream_vbyte_entry {
+	byte_type n_bytes;
+	byte_type shuffle[16];
+};
+
+inline const stream_vbyte_entry* build_stream_vbyte_table() {
+	static stream_vbyte_entry table[256];
+	for (unsigned int control=0; control<256; ++control) {
+		stream_vbyte_entry& entry = table[control];
+		std::memset(entry.shuffle, 0x80, sizeof(entry.shuffle));
+		unsigned int n_bytes = 0;
+		for (unsigned int lane=0; lane<4; ++lane) {
+			const unsigned int length = ((control >> (2 * lane)) & 3) + 1;
+			for (unsigned int i=0; i<length; ++i)
+				entry.shuffle[4 * lane + i] = static_cast<byte_type>(n_bytes + i);
+			n_bytes += length;
+		}
+		entry.n_bytes = static_cast<byte_type>(n_bytes);
+	}
+	return table;
+}
+
+inline const stream_vbyte_entry* stream_vbyte_table() {
+	static const stream_vbyte_entry* table = build_stream_vbyte_table();
+	return table;
+}
+
+/*
+ * number of data bytes of n values
+ */
+inline std::size_t stream_vbyte_data_size(const byte_type* control, std::size_t n) {
+	const stream_vbyte_entry* table = stream_vbyte_table();
+	std::size_t n_bytes = 0;
+	for (std::size_t i=0; i<n/4; ++i)
+		n_bytes += table[control[i]].n_bytes;
+	for (std::size_t i=n/4*4; i<n; ++i)
+		n_bytes += ((control[i / 4] >> (2 * (i % 4))) & 3) + 1;
+	return n_bytes;
+}
+
+/*
+ * writes the control bytes of n values to p, n must be a multiple of 4 unless it is the end of
+ * the array. returns the number of bytes written
+ */
+inline std::size_t encode_stream_vbyte_control(const shift::uint32_t* values, std::size_t n, byte_type* p) {
+	for (std::size_t i=0; i<n; i+=4) {
+		unsigned int control = 0;
+		for (std::size_t j=i; j<n && j<i+4; ++j)
+			control |= stream_vbyte_code(values[j]) << (2 * (j - i));
+		p[i / 4] = static_cast<byte_type>(control);
+	}
+	return stream_vbyte_control_size(n);
+}
+
+/*
+ * writes the data bytes of n values to p, which must hold 4 * n bytes. returns the number of
+ * bytes written
+ */
+inline std::size_t encode_stream_vbyte_data(const shift::uint32_t* values, std::size_t n, byte_type* p) {
+	byte_type* q = p;
+	for (std::size_t i=0; i<n; ++i) {
+		const shift::uint32_t encoded = convert_byte_order<little_endian>(values[i]);
+		std::memcpy(q, &encoded, 4);
+		q += stream_vbyte_code(values[i]) + 1;
+	}
+	return q - p;
+}
+
+/*
+ * decodes n values, the control bytes start with the first of them. the data bytes must end at
+ * data_end. returns the end of the data bytes of the values
+ */
+inline const byte_type* decode_stream_vbyte(const byte_type* control, const byte_type* data, const byte_type* data_end, shift::uint32_t* values, std::size_t n) {
+	std::size_t i = 0;
+
+#if defined __SSSE3__ || defined __AVX2__
+	const stream_vbyte_entry* table = stream_vbyte_table();
+	for (; i + 4 <= n && data_end - data >= 16; i += 4) {
+		const stream_vbyte_entry& entry = table[control[i / 4]];
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entry.shuffle));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), _mm_shuffle_epi8(v, shuffle));
+		data += entry.n_bytes;
+	}
+#endif
+
+	static const shift::uint32_t masks[4] = { 0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF };
+	for (; i<n; ++i) {
+		const unsigned int code = (control[i / 4] >> (2 * (i % 4))) & 3;
+		if (data_end - data >= 4) {
+			shift::uint32_t encoded;
+			std::memcpy(&encoded, data, 4);
+			values[i] = convert_byte_order<little_endian>(encoded) & masks[code];
+		} else {
+			shift::uint32_t value = 0;
+			for (unsigned int j=0; j<=code; ++j)
+				value |= static_cast<shift::uint32_t>(data[j]) << (8 * j);
+			values[i] = value;
+		}
+		data += code + 1;
+	}
+	return data;
+}
+
+}} // shift::detail
+
+#endif /* SHIFT_DETAIL_STREAM_VBYTE_HPP_ */
@@ -51,6 +51,28 @@ template<> struct is_integral<unsigned int      > { static const int value = tru
 template<> struct is_integral<unsigned long     > { static const int value = true; };
 template<> struct is_integral<unsigned long long> { static const int value = true; };
 
+/*
+ * arithmetic types whose encoding is their object representation in the encoding byte order
+ */
+template<typename T> struct has_plain_encoding { static const bool value = false; };
+
+template<> struct has_plain_encoding<  signed char     > { static const bool value = true; };
+template<> struct has_plain_encoding<  signed short    > { static const bool value = true; };
+template<> struct has_plain_encoding<  signed int      > { static const bool value = true; };
+template<> struct has_plain_encoding<  signed long     > { static const bool value = true; };
+template<> struct has_plain_encoding<  signed long long> { static const bool value = true; };
+
+template<> struct has_plain_encoding<unsigned char     > { static const bool value = true; };
+template<> struct has_plain_encoding<unsigned short    > { static const bool value = true; };
+template<> struct has_plain_encoding<unsigned int      > { static const bool value = true; };
+template<> struct has_plain_encoding<unsigned long     > { static const bool value = true; };
+template<> struct has_plain_encoding<unsigned long long> { static const bool value = true; };
+
+template<> struct has_plain_encoding<float             > { static const bool value = true; };
+template<> struct has_plain_encoding<double            > { static const bool value = true; };
+
+template<typename T> struct has_plain_encoding<const T> : has_plain_encoding<T> {};
+
 }} // shift::detail
 
 #endif /* SHIFT_DETAIL_TYPE_TRAITS_HPP_ */
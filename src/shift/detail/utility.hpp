@@ -7,8 +7,12 @@
 #ifndef SHIFT_DETAIL_UTILITY_HPP_
 #define SHIFT_DETAIL_UTILITY_HPP_
 
+#include <cstring>
+#include <cstddef>
+
 #include <shift/types/byte.hpp>
 #include <shift/exception.hpp>
+#include <shift/detail/byte_swap.hpp>
 
 namespace shift { namespace detail {
 
@@ -19,6 +23,39 @@ OutputIteratorType reverse_copy(BidirectionalIteratorType begin, BidirectionalIt
 	return destination;
 }
 
+inline byte_type* reverse_copy(const byte_type* begin, const byte_type* end, byte_type* destination) {
+	reverse_block(begin, end - begin, destination);
+	return destination + (end - begin);
+}
+
+/*
+ * copying of blocks of bytes with or without reversing their order, selected at compile time
+ */
+template<bool ReverseBytes>
+struct block_copy;
+
+template<>
+struct block_copy<false> {
+	template<typename BufferType>
+	static std::size_t write(BufferType& buffer, const byte_type* p, std::size_t current_index, std::size_t n) {
+		return buffer.write(p, current_index, n);
+	}
+	static void read(const byte_type* begin, const byte_type* end, byte_type* destination) {
+		std::memcpy(destination, begin, end - begin);
+	}
+};
+
+template<>
+struct block_copy<true> {
+	template<typename BufferType>
+	static std::size_t write(BufferType& buffer, const byte_type* p, std::size_t current_index, std::size_t n) {
+		return buffer.reverse_write(p, current_index, n);
+	}
+	static void read(const byte_type* begin, const byte_type* end, byte_type* destination) {
+		reverse_copy(begin, end, destination);
+	}
+};
+
 }} // shift::detail
 
 #endif /* SHIFT_DETAIL_UTILITY_HPP_ */
@@ -46,6 +46,26 @@ struct var_int_encoding<false> {
 	}
 };
 
+/*
+ * the unsigned integer a var int is encoded as, for the block encoding of repeated var ints
+ */
+template<typename IntType, bool WithZigZagEncoding = is_signed_integral<IntType>::value>
+struct var_int_value;
+
+template<typename IntType>
+struct var_int_value<IntType, true> {
+	typedef typename zig_zag_encoding_type_traits<IntType>::unsigned_type uint_type;
+	static uint_type encode(IntType  value) { return zig_zag_encode<uint_type>(value); }
+	static IntType   decode(uint_type value) { return zig_zag_decode<IntType>(value); }
+};
+
+template<typename IntType>
+struct var_int_value<IntType, false> {
+	typedef IntType uint_type;
+	static uint_type encode(IntType  value) { return value; }
+	static IntType   decode(uint_type value) { return value; }
+};
+
 template<typename SinkType, typename IntType>
 inline void write_var_int(SinkType& sink, IntType value) {
 	var_int_encoding<detail::is_signed_integral<IntType>::value >::write_var_int(sink, value);
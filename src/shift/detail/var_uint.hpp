@@ -7,24 +7,112 @@
 #ifndef SHIFT_DETAIL_VAR_UINT_HPP_
 #define SHIFT_DETAIL_VAR_UINT_HPP_
 
+#include <limits>
+#include <cstring>
+#include <cstddef>
+
 #include <shift/exception.hpp>
+#include <shift/buffer_position.hpp>
 #include <shift/types/byte.hpp>
+#include <shift/types/cstdint.hpp>
+#include <shift/detail/bit_scan.hpp>
+#include <shift/detail/buffer_traits.hpp>
+#include <shift/detail/endian_reversal.hpp>
 #include <shift/detail/stream_operator_interface.hpp>
 
 namespace shift { namespace detail {
 
-// todo: add documentation: var uints are base 128
+/*
+ * var uints are base 128: the lowest 7 bits come first, the highest bit of a byte is set if another
+ * byte follows. reading throws malformed_var_uint as soon as the multiplier of the next byte would
+ * exceed max_multiplier<UintType>(), i.e. for more than max_decodable_var_uint_size<UintType> bytes.
+ */
+
+/*
+ * maximum number of bytes of an encoded UintType
+ */
+template<typename UintType>
+struct max_var_uint_size { static const std::size_t value = (sizeof(UintType) * 8 + 6) / 7; };
+
+/*
+ * maximum number of bytes read_var_uint accepts for UintType, max_multiplier<UintType>() is
+ * 128^((bits - 8) / 7)
+ */
+template<typename UintType>
+struct max_decodable_var_uint_size { static const std::size_t value = (sizeof(UintType) * 8 - 8) / 7; };
+
+template<typename UintType>
+inline std::size_t var_uint_size(UintType x) {
+	const unsigned int n_bits = significant_bits(x);
+	return n_bits == 0 ? 1 : (n_bits + 6) / 7;
+}
+
+/*
+ * writes the var_uint_size(x) bytes of x to p, returns their end
+ */
+template<typename UintType>
+inline byte_type* encode_var_uint(UintType x, byte_type* p) {
+	byte_type* last = p + var_uint_size(x) - 1;
+	for (; p != last; ++p, x >>= 7)
+		*p = static_cast<byte_type>(x | 128);
+	*p = static_cast<byte_type>(x);
+	return p + 1;
+}
+
+/*
+ * decodes the value at p if it is complete within [p, end) and not longer than max_size bytes,
+ * returns its end or NULL otherwise
+ */
+template<typename UintType>
+inline const byte_type* decode_var_uint(const byte_type* p, const byte_type* end, UintType& value, std::size_t max_size) {
+	const byte_type*  last     = end - p < static_cast<std::ptrdiff_t>(max_size) ? end : p + max_size;
+	UintType          x        = 0;
+	for (unsigned int bits = 0; p != last; bits += 7) {
+		const byte_type b = *p++;
+		x |= static_cast<UintType>(b & 127) << bits;
+		if ((b & 128) == 0) {
+			value = x;
+			return p;
+		}
+	}
+	return NULL;
+}
+
+/*
+ * decodes the value in the 8 bytes at p if it ends within them and is not longer than
+ * max_decodable_var_uint_size, returns its size or 0 otherwise
+ */
+template<typename UintType>
+inline std::size_t decode_var_uint_word(const byte_type* p, UintType& value) {
+	shift::uint64_t word;
+	std::memcpy(&word, p, 8);
+	word = convert_byte_order<little_endian>(word);
+
+	const shift::uint64_t stop_bits = ~word & 0x8080808080808080ULL;
+	if (stop_bits == 0)
+		return 0;
+	const std::size_t size = trailing_zeros(stop_bits) / 8 + 1;
+	if (size > max_decodable_var_uint_size<UintType>::value)
+		return 0;
+
+	UintType x = 0;
+	for (std::size_t i=0; i<size; ++i, word >>= 8)
+		x |= static_cast<UintType>(word & 127) << (7 * i);
+	value = x;
+	return size;
+}
 
+/*
+ * sinks over a counting_buffer are only advanced by the size of the value
+ */
 template<typename SinkType, typename UintType>
 void write_var_uint(SinkType& sink, UintType X) {
-	typedef shift::byte_type byte_type;
-	do {
-		byte_type encoded_byte = X % 128;
-		X /= 128;
-		if (X > 0)
-			encoded_byte = encoded_byte | 128;
-		ostream_operator_interface<SinkType>::write(sink, encoded_byte);
-	} while (X > 0);
+	if (is_counting_buffer<typename SinkType::buffer_type>::value) {
+		ostream_operator_interface<SinkType>::write_array(sink, NULL, var_uint_size(X));
+		return;
+	}
+	byte_type encoded[max_var_uint_size<UintType>::value];
+	ostream_operator_interface<SinkType>::write_array(sink, encoded, encode_var_uint(X, encoded) - encoded);
 }
 
 template<typename UintType>
@@ -41,21 +129,37 @@ UintType max_multiplier() {
 	return max_multiplier;
 }
 
+/*
+ * byte by byte, for values that end beyond the bytes available in the source or are malformed.
+ * throws malformed_var_uint when byte max_size + 1 is read, which is where the multiplier of
+ * read_var_uint exceeds max_multiplier<UintType>() for max_decodable_var_uint_size<UintType>
+ */
 template<typename SourceType, typename UintType>
-void read_var_uint(SourceType& source, UintType& value) {
-	typedef shift::byte_type byte_type;
-	typedef UintType         value_type;
-	value                   = 0;
-	value_type multiplier   = 1;
-	byte_type  encoded_byte = 0;
-
-	do {
-		encoded_byte = istream_operator_interface<SourceType>::get(source);
-		value += (encoded_byte & 127) * multiplier;
-		multiplier *= 128;
-		if (multiplier > max_multiplier<UintType>())
+void read_var_uint_bytes(SourceType& source, UintType& value, std::size_t max_size) {
+	UintType x = 0;
+	for (std::size_t i=0; ; ++i) {
+		const byte_type encoded_byte = istream_operator_interface<SourceType>::get(source);
+		if (i == max_size)
 			SHIFT_THROW(malformed_var_uint());
-	} while ((encoded_byte & 128) != 0);
+		x |= static_cast<UintType>(encoded_byte & 127) << (7 * i);
+		if ((encoded_byte & 128) == 0)
+			break;
+	}
+	value = x;
+}
+
+template<typename SourceType, typename UintType>
+void read_var_uint(SourceType& source, UintType& value) {
+	typedef istream_operator_interface<SourceType> interface_type;
+	const std::size_t index = interface_type::get_position(source).byte_index;
+	if (interface_type::request(source, index, 1) > 0 && interface_type::available(source, index) >= 8) {
+		const std::size_t size = decode_var_uint_word(interface_type::location(source, index), value);
+		if (size > 0) {
+			interface_type::set_position(source, buffer_position(index + size, 7));
+			return;
+		}
+	}
+	read_var_uint_bytes(source, value, max_decodable_var_uint_size<UintType>::value);
 }
 
 }} // shift::detail
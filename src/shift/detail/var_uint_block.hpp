@@ -0,0 +1,239 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_DETAIL_VAR_UINT_BLOCK_HPP_
+#define SHIFT_DETAIL_VAR_UINT_BLOCK_HPP_
+
+#include <cstring>
+#include <cstddef>
+
+#include <shift/types/byte.hpp>
+#include <shift/types/cstdint.hpp>
+#include <shift/buffer_position.hpp>
+#include <shift/detail/var_uint.hpp>
+#include <shift/detail/stream_operator_interface.hpp>
+
+#if defined __SSSE3__ || defined __AVX2__
+	#include <immintrin.h>
+#endif
+
+namespace shift {
+namespace detail {
+
+/*
+ * encoding and decoding of arrays of var uints in the format of write_var_uint and read_var_uint,
+ * without bounds checks per byte. the number of values per block of the repeated field operators
+ */
+static const std::size_t var_uint_block_size = 64;
+
+#if defined __SSSE3__ || defined __AVX2__
+
+/*
+ * runs of values below 128 are packed 16 at a time, only for 4 byte values
+ */
+template<std::size_t Size>
+struct small_var_uint_run {
+	template<typename UintType>
+	static std::size_t encode(const UintType*, std::size_t, byte_type*) { return 0; }
+};
+
+template<>
+struct small_var_uint_run<4> {
+	template<typename UintType>
+	static std::size_t encode(const UintType* values, std::size_t n, byte_type* p) {
+		const __m128i zero = _mm_setzero_si128();
+		std::size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i     ));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i +  4));
+			const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i +  8));
+			const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 12));
+			const __m128i high = _mm_srli_epi32(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), 7);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xFFFF)
+				break;
+			const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), packed);
+		}
+		return i;
+	}
+};
+
+/*
+ * shuffle table in the style of masked vbyte: indexed by the continuation bits of 8 bytes, each
+ * entry gathers the values that are complete within these bytes and have 1 or 2 bytes into 16 bit
+ * lanes. values of 3 bytes or more end the entry.
+ */
+struct var_uint_shuffle_entry {
+	byte_type n_values;
+	byte_type n_bytes;
+	byte_type shuffle[16];
+};
+
+inline const var_uint_shuffle_entry* build_var_uint_shuffle_table() {
+	static var_uint_shuffle_entry table[256];
+	for (unsigned int mask=0; mask<256; ++mask) {
+		var_uint_shuffle_entry& entry = table[mask];
+		std::memset(entry.shuffle, 0x80, sizeof(entry.shuffle));
+		unsigned int begin = 0, n_values = 0;
+		while (begin < 8) {
+			unsigned int end = begin;
+			while (end < 8 && (mask & (1u << end)) != 0) ++end;
+			if (end == 8 || end - begin > 1)
+				break;
+			entry.shuffle[2 * n_values] = static_cast<byte_type>(begin);
+			if (end > begin)
+				entry.shuffle[2 * n_values + 1] = static_cast<byte_type>(end);
+			++n_values;
+			begin = end + 1;
+		}
+		entry.n_values = static_cast<byte_type>(n_values);
+		entry.n_bytes  = static_cast<byte_type>(begin);
+	}
+	return table;
+}
+
+inline const var_uint_shuffle_entry* var_uint_shuffle_table() {
+	static const var_uint_shuffle_entry* table = build_var_uint_shuffle_table();
+	return table;
+}
+
+/*
+ * decodes whole blocks of 16 bytes while the values have at most 2 bytes, returns the number of
+ * values decoded and advances p
+ */
+template<typename UintType>
+inline std::size_t decode_small_var_uints(const byte_type*& p, const byte_type* end, UintType* values, std::size_t n, std::size_t max_size) {
+	if (max_size < 2)
+		return 0;
+
+	const var_uint_shuffle_entry* table = var_uint_shuffle_table();
+	const __m128i low_bits  = _mm_set1_epi16(0x007F);
+	const __m128i high_bits = _mm_set1_epi16(0x7F00);
+	std::size_t i = 0;
+	while (end - p >= 16 && n - i >= 16) {
+		const __m128i   data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		const unsigned int mask = _mm_movemask_epi8(data);
+		if (mask == 0) {
+			for (unsigned int j=0; j<16; ++j)
+				values[i + j] = p[j];
+			i += 16;
+			p += 16;
+			continue;
+		}
+		const var_uint_shuffle_entry& entry = table[mask & 0xFF];
+		if (entry.n_values == 0)
+			break;
+		const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entry.shuffle));
+		const __m128i lanes   = _mm_shuffle_epi8(data, shuffle);
+		const __m128i decoded = _mm_or_si128(_mm_and_si128(lanes, low_bits), _mm_srli_epi16(_mm_and_si128(lanes, high_bits), 1));
+		uint16_t      lane_values[8];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lane_values), decoded);
+		for (unsigned int j=0; j<entry.n_values; ++j)
+			values[i + j] = lane_values[j];
+		i += entry.n_values;
+		p += entry.n_bytes;
+	}
+	return i;
+}
+
+#else
+
+template<std::size_t Size>
+struct small_var_uint_run {
+	template<typename UintType>
+	static std::size_t encode(const UintType*, std::size_t, byte_type*) { return 0; }
+};
+
+template<typename UintType>
+inline std::size_t decode_small_var_uints(const byte_type*&, const byte_type*, UintType*, std::size_t, std::size_t) {
+	return 0;
+}
+
+#endif
+
+/*
+ * encodes n values to p, which must hold n * max_var_uint_size<UintType> bytes. returns the number
+ * of bytes written
+ */
+template<typename UintType>
+inline std::size_t encode_var_uints(const UintType* values, std::size_t n, byte_type* p) {
+	byte_type* q = p;
+	std::size_t i = 0;
+	while (i < n) {
+		const std::size_t n_run = small_var_uint_run<sizeof(UintType)>::encode(values + i, n - i, q);
+		i += n_run;
+		q += n_run;
+		for (const std::size_t n_scalar = i + 16 < n ? i + 16 : n; i < n_scalar; ++i)
+			q = encode_var_uint(values[i], q);
+	}
+	return q - p;
+}
+
+/*
+ * decodes up to n values from [p, p + n_bytes), stopping before the first value that is incomplete
+ * within the range or longer than max_size bytes. returns the number of values decoded, n_consumed
+ * receives the number of bytes they occupy
+ */
+template<typename UintType>
+inline std::size_t decode_var_uints(const byte_type* p, std::size_t n_bytes, UintType* values, std::size_t n, std::size_t& n_consumed, std::size_t max_size) {
+	const byte_type* begin = p;
+	const byte_type* end   = p + n_bytes;
+	std::size_t i = 0;
+	while (i < n) {
+		i += decode_small_var_uints(p, end, values + i, n - i, max_size);
+		if (i == n)
+			break;
+
+		uint64_t word;
+		if (max_size > 0 && end - p >= 8 && n - i >= 8) {
+			std::memcpy(&word, p, 8);
+			if ((word & 0x8080808080808080ULL) == 0) {
+				for (unsigned int j=0; j<8; ++j)
+					values[i + j] = p[j];
+				i += 8;
+				p += 8;
+				continue;
+			}
+		}
+
+		const byte_type* next = decode_var_uint(p, end, values[i], max_size);
+		if (next == NULL)
+			break;
+		p = next;
+		++i;
+	}
+	n_consumed = p - begin;
+	return i;
+}
+
+/*
+ * reads n values of up to max_size bytes from the source. the bytes in the window of the source
+ * are decoded in blocks, values that end beyond them are read byte by byte
+ */
+template<typename SourceType, typename UintType>
+void read_var_uints(SourceType& source, UintType* values, std::size_t n, std::size_t max_size) {
+	typedef istream_operator_interface<SourceType> interface_type;
+	for (std::size_t i=0; i<n; ) {
+		const std::size_t position  = interface_type::get_position(source).byte_index;
+		const std::size_t n_bytes   = interface_type::request(source, position, 1) > 0 ? interface_type::available(source, position) : 0;
+		std::size_t       n_decoded = 0;
+		std::size_t       n_used    = 0;
+		if (n_bytes > 0)
+			n_decoded = decode_var_uints(interface_type::location(source, position), n_bytes, values + i, n - i, n_used, max_size);
+
+		if (n_decoded == 0) {
+			read_var_uint_bytes(source, values[i], max_size);
+			++i;
+			continue;
+		}
+		interface_type::set_position(source, buffer_position(position + n_used, 7));
+		i += n_decoded;
+	}
+}
+
+}} // shift::detail
+
+#endif /* SHIFT_DETAIL_VAR_UINT_BLOCK_HPP_ */
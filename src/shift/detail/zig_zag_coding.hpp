@@ -7,6 +7,8 @@
 #ifndef SHIFT_DETAIL_ZIG_ZAG_CODING_HPP_
 #define SHIFT_DETAIL_ZIG_ZAG_CODING_HPP_
 
+#include <climits>
+
 namespace shift { namespace detail {
 
 /*
@@ -7,6 +7,7 @@
 #ifndef SHIFT_EXCEPTION_HPP_
 #define SHIFT_EXCEPTION_HPP_
 
+#include <cstddef>
 #include <exception>
 #include <utility>
 #include <string>
@@ -64,32 +65,40 @@ public:
 class out_of_range : public exception {
 public:
 
-	typedef std::pair<unsigned, unsigned> range_type;
+	typedef std::pair<std::size_t, std::size_t> range_type;
 
-	out_of_range(unsigned value, unsigned range_begin, unsigned range_end)
+	out_of_range(std::size_t value, std::size_t range_begin, std::size_t range_end)
 	: exception(generate_what_string(value, range_begin, range_end))
 	, value_   (value)
 	, range_   (range_begin, range_end)
 	{}
 
-	unsigned   value() const { return value_; }
-	range_type range() const { return range_; }
+	std::size_t value() const { return value_; }
+	range_type  range() const { return range_; }
 
 private:
 
-	std::string generate_what_string(unsigned value, unsigned range_begin, unsigned range_end) {
+	std::string generate_what_string(std::size_t value, std::size_t range_begin, std::size_t range_end) {
 		std::stringstream sstr;
 		sstr << "value '" << value << "' out of range [" << range_begin << ", " << range_end << ")";
 		return sstr.str();
 	}
 
-	const unsigned   value_;
-	const range_type range_;
+	const std::size_t value_;
+	const range_type  range_;
 };
 
 #define SHIFT_THROW_ON_INDEX_OUT_OF_RANGE(index, range_begin, range_end)\
 	if (index < range_begin || index >= range_end) SHIFT_THROW( out_of_range(index, range_begin, range_end) )
 
+class io_error : public exception {
+public:
+	io_error(const std::string& str = "", int error_number = 0) : exception(str), error_number_(error_number) {}
+	int error_number() const { return error_number_; }
+private:
+	int error_number_;
+};
+
 class malformed_var_uint : public exception {
 public:
 	malformed_var_uint(const std::string& str="") : exception(""){}
@@ -0,0 +1,127 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_LENGTH_PREFIX_HPP_
+#define SHIFT_LENGTH_PREFIX_HPP_
+
+#include <limits>
+#include <cstddef>
+
+#include <shift/sink.hpp>
+#include <shift/exception.hpp>
+#include <shift/concepts/size_tags.hpp>
+#include <shift/detail/var_uint.hpp>
+#include <shift/detail/stream_operator_interface.hpp>
+
+namespace shift {
+
+namespace detail {
+
+/*
+ * integral size types are written as their value, of which all bytes are reserved
+ */
+template<typename SizeType>
+struct length_prefix_encoding {
+	static const std::size_t default_size = sizeof(SizeType);
+
+	static std::size_t size(std::size_t) {
+		return sizeof(SizeType);
+	}
+
+	template<typename SinkType>
+	static void write(SinkType& sink, std::size_t length, std::size_t) {
+		if (length > static_cast<std::size_t>(std::numeric_limits<SizeType>::max()))
+			SHIFT_THROW(out_of_range(length, 0, range_end()));
+		sink << static_cast<SizeType>(length);
+	}
+
+	/*
+	 * the end of the range of lengths, limited to the largest std::size_t the exception holds
+	 */
+	static std::size_t range_end() {
+		const std::size_t max_end = std::numeric_limits<std::size_t>::max();
+		return static_cast<std::size_t>(std::numeric_limits<SizeType>::max()) < max_end ? static_cast<std::size_t>(std::numeric_limits<SizeType>::max()) + 1 : max_end;
+	}
+};
+
+/*
+ * variable_length sizes are written as var uints padded to n_bytes with continuation bytes, at most
+ * as many as read_var_uint accepts for the unsigned int of size_decoder
+ */
+template<>
+struct length_prefix_encoding<variable_length> {
+	static const std::size_t default_size = max_decodable_var_uint_size<unsigned int>::value;
+
+	static std::size_t size(std::size_t n_bytes) {
+		if (n_bytes == 0 || n_bytes > default_size)
+			SHIFT_THROW(out_of_range(n_bytes, 1, default_size + 1));
+		return n_bytes;
+	}
+
+	template<typename SinkType>
+	static void write(SinkType& sink, std::size_t length, std::size_t n_bytes) {
+		if (length >> (7 * n_bytes) != 0)
+			SHIFT_THROW(out_of_range(length, 0, 1u << (7 * n_bytes)));
+		byte_type encoded[default_size];
+		for (std::size_t i=0; i<n_bytes; ++i, length >>= 7)
+			encoded[i] = static_cast<byte_type>((length & 127) | (i + 1 < n_bytes ? 128 : 0));
+		ostream_operator_interface<SinkType>::write_array(sink, encoded, n_bytes);
+	}
+};
+
+} // detail
+
+/*
+ * reserves the size field of a length delimited field at the current position of a sink, so the
+ * field is written directly into the sink; commit() writes the number of bytes from the end of the
+ * size field to the current position into it and throws out_of_range if it does not fit. for
+ * variable_length the number of bytes of the size field is given, up to 3.
+ *
+ * the size field stays zero if commit() is not called.
+ */
+template<typename SizeType, typename SinkType>
+class length_prefix {
+public:
+
+	explicit length_prefix(SinkType& sink, std::size_t n_bytes = detail::length_prefix_encoding<SizeType>::default_size)
+	: sink_   (sink)
+	, n_bytes_(detail::length_prefix_encoding<SizeType>::size(n_bytes))
+	, begin_  (interface_type::get_position(sink).byte_index)
+	{
+		const byte_type placeholder[8] = {};
+		interface_type::write_array(sink_, placeholder, n_bytes_);
+	}
+
+	/*
+	 * the number of bytes written after the size field so far
+	 */
+	std::size_t length() const {
+		return interface_type::get_position(sink_).byte_index - begin_ - n_bytes_;
+	}
+
+	void commit() {
+		const buffer_position end = interface_type::get_position(sink_);
+		const std::size_t     n   = length();
+		interface_type::set_position(sink_, buffer_position(begin_, 7));
+		detail::length_prefix_encoding<SizeType>::write(sink_, n, n_bytes_);
+		interface_type::set_position(sink_, end);
+	}
+
+private:
+
+	typedef detail::ostream_operator_interface<SinkType> interface_type;
+
+	length_prefix(const length_prefix&);
+	length_prefix& operator=(const length_prefix&);
+
+	SinkType&         sink_;
+	const std::size_t n_bytes_;
+	const std::size_t begin_;
+};
+
+} // shift
+
+#endif /* SHIFT_LENGTH_PREFIX_HPP_ */
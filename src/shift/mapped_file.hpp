@@ -0,0 +1,99 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_MAPPED_FILE_HPP_
+#define SHIFT_MAPPED_FILE_HPP_
+
+#include <cerrno>
+#include <cstring>
+#include <cstddef>
+#include <string>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <shift/exception.hpp>
+#include <shift/types/byte.hpp>
+#include <shift/source.hpp>
+
+namespace shift {
+
+/*
+ * read only memory mapping of a whole file, to construct a source that decodes directly from the
+ * page cache. the access pattern is passed on to the kernel with madvise. the file descriptor is not
+ * owned and may be closed once the mapping exists; the mapping must outlive sources made from it.
+ */
+class mapped_file {
+public:
+
+	enum access_pattern {
+		normal_access,
+		sequential_access,
+		random_access
+	};
+
+	explicit mapped_file(int fd, access_pattern pattern = sequential_access)
+	: data_(NULL)
+	, size_(0)
+	{
+		if (fd < 0) SHIFT_THROW(not_initialized("mapped_file::mapped_file() : invalid file descriptor passed"));
+
+		struct stat status;
+		if (::fstat(fd, &status) != 0) throw_io_error("fstat");
+		size_ = static_cast<std::size_t>(status.st_size);
+		if (size_ == 0)
+			return;
+
+		void* p = ::mmap(NULL, size_, PROT_READ, MAP_SHARED, fd, 0);
+		if (p == MAP_FAILED) throw_io_error("mmap");
+		data_ = static_cast<const byte_type*>(p);
+
+		::madvise(p, size_, advice(pattern));
+	}
+
+	~mapped_file() {
+		if (data_ != NULL) ::munmap(const_cast<byte_type*>(data_), size_);
+	}
+
+	const byte_type* data() const {
+		return data_;
+	}
+
+	std::size_t size() const {
+		return size_;
+	}
+
+	template<endianness EncodingEndianness>
+	source<EncodingEndianness> make_source() const {
+		return source<EncodingEndianness>(data_, size_);
+	}
+
+private:
+
+	mapped_file(const mapped_file&);
+	mapped_file& operator=(const mapped_file&);
+
+	static int advice(access_pattern pattern) {
+		switch (pattern) {
+		case sequential_access: return MADV_SEQUENTIAL;
+		case random_access    : return MADV_RANDOM;
+		default               : return MADV_NORMAL;
+		}
+	}
+
+	static void throw_io_error(const char* function) {
+		const int error_number = errno;
+		SHIFT_THROW(io_error(std::string("mapped_file: ") + function + " failed: " + std::strerror(error_number), error_number));
+	}
+
+	const byte_type* data_;
+	std::size_t      size_;
+};
+
+} // shift
+
+#endif /* SHIFT_MAPPED_FILE_HPP_ */
@@ -0,0 +1,208 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_OPERATOR_CONVERTED_REPEATED_HPP_
+#define SHIFT_OPERATOR_CONVERTED_REPEATED_HPP_
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/concepts/size_tags.hpp>
+#include <shift/detail/size_encoding.hpp>
+#include <shift/detail/batch_conversion.hpp>
+#include <shift/operator/repeated.hpp>
+
+namespace shift {
+
+namespace detail {
+
+/*
+ * the encoded values of converted repeated fields are converted and encoded in blocks of
+ * batch_conversion_block_size values, unless the size tag selects a format of the whole field
+ * like delta_coding, for which they are converted into a vector first
+ */
+template<typename SizeType, typename T>
+struct converts_in_blocks {
+	static const bool value = repeated_encoding<SizeType, const T*>::value == iterator_encoding<const T*>::value;
+};
+
+template<typename ConverterType, bool InBlocks>
+struct converted_repeated_elements;
+
+template<typename ConverterType>
+struct converted_repeated_elements<ConverterType, true> {
+	typedef typename ConverterType::decoded_type decoded_type;
+	typedef typename ConverterType::encoded_type encoded_type;
+	typedef typename ConverterType::params       params_type;
+
+	template<typename SizeType, typename SinkType, typename ForwardIteratorType>
+	static void encode(SinkType& sink, ForwardIteratorType begin, ForwardIteratorType end, const params_type& p) {
+		decoded_type values [batch_conversion_block_size];
+		encoded_type encoded[batch_conversion_block_size];
+		while (begin != end) {
+			std::size_t n = 0;
+			for (; n < batch_conversion_block_size && begin != end; ++n, ++begin)
+				values[n] = *begin;
+			encode_batch<ConverterType>(values, n, p, encoded);
+			repeated_elements<iterator_encoding<const encoded_type*>::value>::encode(sink, static_cast<const encoded_type*>(encoded), static_cast<const encoded_type*>(encoded + n));
+		}
+	}
+
+	template<typename SizeType, typename SourceType, typename OutputIteratorType>
+	static void decode(SourceType& source, OutputIteratorType& iterator, unsigned int length, const params_type& p) {
+		encoded_type encoded[batch_conversion_block_size];
+		decoded_type values [batch_conversion_block_size];
+		while (length > 0) {
+			const unsigned int n = length < batch_conversion_block_size ? length : static_cast<unsigned int>(batch_conversion_block_size);
+			encoded_type* encoded_iterator = encoded;
+			decode_repeated(source, encoded_iterator, n);
+			decode_batch<ConverterType>(encoded, n, p, values);
+			iterator = std::copy(values, values + n, iterator);
+			length  -= n;
+		}
+	}
+};
+
+template<typename ConverterType>
+struct converted_repeated_elements<ConverterType, false> {
+	typedef typename ConverterType::decoded_type decoded_type;
+	typedef typename ConverterType::encoded_type encoded_type;
+	typedef typename ConverterType::params       params_type;
+
+	template<typename SizeType, typename SinkType, typename ForwardIteratorType>
+	static void encode(SinkType& sink, ForwardIteratorType begin, ForwardIteratorType end, const params_type& p) {
+		const std::vector<decoded_type> values(begin, end);
+		std::vector<encoded_type> encoded(values.size());
+		if (!values.empty())
+			encode_batch<ConverterType>(&values[0], values.size(), p, &encoded[0]);
+		typedef typename std::vector<encoded_type>::const_iterator encoded_iterator;
+		repeated_elements<repeated_encoding<SizeType, encoded_iterator>::value>::encode(sink, encoded_iterator(encoded.begin()), encoded_iterator(encoded.end()));
+	}
+
+	template<typename SizeType, typename SourceType, typename OutputIteratorType>
+	static void decode(SourceType& source, OutputIteratorType& iterator, unsigned int length, const params_type& p) {
+		std::vector<encoded_type> encoded;
+		std::back_insert_iterator<std::vector<encoded_type> > encoded_iterator(encoded);
+		repeated_decoding<SizeType>::decode(source, encoded_iterator, length);
+		decoded_type values[batch_conversion_block_size];
+		for (std::size_t i=0; i<encoded.size(); i+=batch_conversion_block_size) {
+			const std::size_t n = std::min(encoded.size() - i, batch_conversion_block_size);
+			decode_batch<ConverterType>(&encoded[i], n, p, values);
+			iterator = std::copy(values, values + n, iterator);
+		}
+	}
+};
+
+template<typename SizeType, typename ConverterType>
+struct converted_repeated : converted_repeated_elements<ConverterType, converts_in_blocks<SizeType, typename ConverterType::encoded_type>::value> {};
+
+} // detail
+
+/*
+ * repeated fields of which the elements are converted with ConverterType, like the converter
+ * converts a single value, without converting the field into a temporary container first. ConverterType
+ * needs static encode(decoded_type, params) and decode(encoded_type, params) like the converters in
+ * converter.hpp and combined_converter; its params are given instead of a value.
+ */
+template<typename SizeType, typename ConverterType, typename ForwardIteratorType>
+class orepeated_converted {
+public:
+	typedef typename ConverterType::params params_type;
+
+	orepeated_converted(ForwardIteratorType begin, ForwardIteratorType end, const params_type& p = params_type()) : begin(begin), end(end), p(p) {}
+
+	ForwardIteratorType begin;
+	ForwardIteratorType end;
+	params_type         p;
+private:
+	template<endianness EncodingEndianness, typename BufferType, typename SizeType__, typename ConverterType__, typename ForwardIteratorType__>
+	friend sink<EncodingEndianness, BufferType>& operator << (sink<EncodingEndianness, BufferType>&, const orepeated_converted<SizeType__, ConverterType__, ForwardIteratorType__>&);
+
+	template<typename SinkType>
+	unsigned int encode_size(SinkType& sink) const {
+		return detail::size_encoder<SizeType>::encode(sink, std::distance(begin, end));
+	}
+};
+
+template<endianness EncodingEndianness, typename BufferType, typename SizeType, typename ConverterType, typename ForwardIteratorType>
+sink<EncodingEndianness, BufferType>& operator << (sink<EncodingEndianness, BufferType>& sink_, const orepeated_converted<SizeType, ConverterType, ForwardIteratorType>& repeated_) {
+	repeated_.encode_size(sink_);
+	detail::converted_repeated<SizeType, ConverterType>::template encode<SizeType>(sink_, repeated_.begin, repeated_.end, repeated_.p);
+	return sink_;
+}
+
+/////
+
+template<typename SizeType, typename ConverterType, typename OutputIteratorType>
+class irepeated_converted {
+public:
+	typedef typename ConverterType::params params_type;
+
+	explicit irepeated_converted(OutputIteratorType back_inserter, const params_type& p = params_type()) : iterator(back_inserter), p(p) {}
+	OutputIteratorType iterator;
+	params_type        p;
+private:
+	template<endianness EncodingEndianness, typename InputType, typename SizeType__, typename ConverterType__, typename OutputIteratorType__>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>&, irepeated_converted<SizeType__, ConverterType__, OutputIteratorType__>);
+
+	template<typename SourceType>
+	unsigned int decode_size(SourceType& source) {
+		return detail::size_decoder<SizeType>::decode_size(source);
+	}
+};
+
+template<typename ConverterType, typename OutputIteratorType>
+class irepeated_converted<no_size_field, ConverterType, OutputIteratorType> {
+public:
+	typedef typename ConverterType::params params_type;
+
+	irepeated_converted(OutputIteratorType back_inserter, unsigned int size, const params_type& p = params_type()) : iterator(back_inserter), size(size), p(p) {}
+	OutputIteratorType iterator;
+	const unsigned int size;
+	params_type        p;
+private:
+	template<endianness EncodingEndianness, typename InputType, typename SizeType__, typename ConverterType__, typename OutputIteratorType__>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>&, irepeated_converted<SizeType__, ConverterType__, OutputIteratorType__>);
+
+	template<typename SourceType>
+	unsigned int decode_size(SourceType&) {
+		return size;
+	}
+};
+
+template<unsigned int Size, typename ConverterType, typename OutputIteratorType>
+class irepeated_converted<static_size<Size>, ConverterType, OutputIteratorType> {
+public:
+	typedef typename ConverterType::params params_type;
+
+	explicit irepeated_converted(OutputIteratorType back_inserter, const params_type& p = params_type()) : iterator(back_inserter), p(p) {}
+	OutputIteratorType iterator;
+	static const unsigned int size = Size;
+	params_type        p;
+private:
+	template<endianness EncodingEndianness, typename InputType, typename SizeType__, typename ConverterType__, typename OutputIteratorType__>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>&, irepeated_converted<SizeType__, ConverterType__, OutputIteratorType__>);
+
+	template<typename SourceType>
+	unsigned int decode_size(SourceType&) {
+		return size;
+	}
+};
+
+template<endianness EncodingEndianness, typename InputType, typename SizeType, typename ConverterType, typename OutputIteratorType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, irepeated_converted<SizeType, ConverterType, OutputIteratorType> repeated_) {
+	const unsigned int length = repeated_.decode_size(source_);
+	detail::converted_repeated<SizeType, ConverterType>::template decode<SizeType>(source_, repeated_.iterator, length, repeated_.p);
+	return source_;
+}
+
+} // shift
+
+#endif /* SHIFT_OPERATOR_CONVERTED_REPEATED_HPP_ */
@@ -7,22 +7,23 @@
 #ifndef SHIFT_OPERATOR_CONVERTER_HPP_
 #define SHIFT_OPERATOR_CONVERTER_HPP_
 
+#include <shift/sink.hpp>
 #include <shift/source.hpp>
 #include <shift/types/converter.hpp>
 
 namespace shift {
 
-template<endianness EncodingEndianness, typename BufferType, typename DecodedType, typename EncodedType>
-sink<EncodingEndianness, BufferType>& operator << (sink<EncodingEndianness, BufferType>& sink_, const converter<DecodedType, EncodedType>& conv_functor) {
-	sink_ << conv_functor.encode();
+template<endianness EncodingEndianness, typename BufferType, typename ConverterType>
+sink<EncodingEndianness, BufferType>& operator << (sink<EncodingEndianness, BufferType>& sink_, const converter<ConverterType>& conv_functor) {
+	sink_ << conv_functor.derived().encode();
 	return sink_;
 }
 
-template<endianness EncodingEndianness, typename DecodedType, typename EncodedType>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, const converter<DecodedType, EncodedType>& conv_functor) {
-	EncodedType tmp;
+template<endianness EncodingEndianness, typename InputType, typename ConverterType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, const converter<ConverterType>& conv_functor) {
+	typename ConverterType::encoded_type tmp;
 	source_ >> tmp;
-	conv_functor.decode(tmp);
+	conv_functor.derived().decode(tmp);
 	return source_;
 }
 
@@ -14,8 +14,8 @@ struct noop{};
 template<endianness EncodingEndianness, typename BufferType>
 sink<EncodingEndianness, BufferType>& operator << (sink<EncodingEndianness, BufferType>& sink_, noop value) { /* empty */ }
 
-template<endianness EncodingEndianness>
-source<EncodingEndianness>&           operator >> (source<EncodingEndianness>& source_        , noop value) { /* empty */ }
+template<endianness EncodingEndianness, typename InputType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, noop value) { /* empty */ }
 
 }
 
@@ -7,13 +7,492 @@
 #ifndef SHIFT_OPERATOR_REPEATED_HPP_
 #define SHIFT_OPERATOR_REPEATED_HPP_
 
+#include <vector>
+#include <iterator>
+#include <cstddef>
+
 #include <shift/sink.hpp>
 #include <shift/source.hpp>
 #include <shift/concepts/size_tags.hpp>
 #include <shift/detail/size_encoding.hpp>
+#include <shift/detail/type_traits.hpp>
+#include <shift/detail/endian_reversal.hpp>
+#include <shift/detail/byte_swap.hpp>
+#include <shift/detail/var_int.hpp>
+#include <shift/detail/var_uint_block.hpp>
+#include <shift/detail/stream_vbyte.hpp>
+#include <shift/detail/delta_coding.hpp>
+#include <shift/detail/bit_packing.hpp>
+#include <shift/detail/frame_of_reference.hpp>
+#include <shift/detail/static_assert.hpp>
+#include <shift/types/var_int.hpp>
+#include <shift/detail/stream_operator_interface.hpp>
 
 namespace shift {
 
+namespace detail {
+
+template<typename ContainerType>
+struct back_inserted_container : std::back_insert_iterator<ContainerType> {
+	static ContainerType& get(std::back_insert_iterator<ContainerType>& iterator) {
+		return *(iterator.*(&back_inserted_container::container));
+	}
+};
+
+/*
+ * elements of a repeated field are encoded and decoded one by one, except for contiguous arrays of
+ * arithmetic types (pointers and std::vector back inserters), which are copied as a single block,
+ * and var ints, which are converted in blocks of var_uint_block_size values. fields with the
+ * stream_vbyte, delta_coding, delta_of_delta_coding, bit_packed, frame_of_reference or
+ * patched_frame_of_reference size tags are always converted in blocks
+ */
+enum repeated_element_encoding { element_wise_encoding, block_encoding, var_int_block_encoding, stream_vbyte_encoding, delta_encoding, delta_of_delta_encoding, bit_packed_encoding, frame_of_reference_encoding, patched_frame_of_reference_encoding };
+
+template<repeated_element_encoding Encoding>
+struct repeated_elements;
+
+template<>
+struct repeated_elements<element_wise_encoding> {
+	template<typename SinkType, typename ForwardIteratorType>
+	static void encode(SinkType& sink, ForwardIteratorType begin, ForwardIteratorType end) {
+		for (ForwardIteratorType it = begin; it != end; ++it) sink << *it;
+	}
+
+	template<typename SourceType, typename OutputIteratorType>
+	static void decode(SourceType& source, OutputIteratorType& iterator, unsigned int length) {
+		for (unsigned int i=0; i<length; ++i) source >> *iterator++;
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename T, typename AllocatorType>
+	static void decode(source<EncodingEndianness, InputType>& source_, std::vector<T, AllocatorType>& values, unsigned int length) {
+		reserve_remaining(source_, values, length);
+		std::back_insert_iterator<std::vector<T, AllocatorType> > iterator(values);
+		decode(source_, iterator, length);
+	}
+
+	/*
+	 * the vector is reserved for the decoded number of elements, but not beyond the size of the remaining input
+	 */
+	template<endianness EncodingEndianness, typename InputType, typename T, typename AllocatorType>
+	static void reserve_remaining(source<EncodingEndianness, InputType>& source_, std::vector<T, AllocatorType>& values, unsigned int length) {
+		typedef istream_operator_interface<source<EncodingEndianness, InputType> > interface_type;
+		const std::size_t position  = interface_type::get_position(source_).byte_index;
+		const std::size_t remaining = source_.size() > position ? source_.size() - position : 0;
+		values.reserve(values.size() + (length < remaining ? length : remaining));
+	}
+};
+
+template<>
+struct repeated_elements<block_encoding> {
+	template<typename SinkType, typename T>
+	static void encode(SinkType& sink, const T* begin, const T* end) {
+		ostream_operator_interface<SinkType>::write_values(sink, begin, end - begin);
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename T>
+	static void decode(source<EncodingEndianness, InputType>& source_, T* values, unsigned int length) {
+		typedef istream_operator_interface<source<EncodingEndianness, InputType> > interface_type;
+		const std::pair<const byte_type*, const byte_type*> block = interface_type::get_array(source_, length * sizeof(T));
+		decode_values<EncodingEndianness>(block.first, length, values);
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename T, typename AllocatorType>
+	static void decode(source<EncodingEndianness, InputType>& source_, std::vector<T, AllocatorType>& values, unsigned int length) {
+		typedef istream_operator_interface<source<EncodingEndianness, InputType> > interface_type;
+		const std::pair<const byte_type*, const byte_type*> block = interface_type::get_array(source_, length * sizeof(T));
+		const std::size_t n_values = values.size();
+		values.resize(n_values + length);
+		if (length > 0)
+			decode_values<EncodingEndianness>(block.first, length, &values[n_values]);
+	}
+};
+
+/*
+ * the encoding is byte identical to encoding the elements one by one. decoding takes the bytes
+ * that are available in the source without bounds checks per byte; a value that is not complete
+ * within them, or that read_var_uint rejects, is read one by one so out_of_range and
+ * malformed_var_uint are thrown as before
+ */
+template<>
+struct repeated_elements<var_int_block_encoding> {
+	template<typename SinkType, typename ForwardIteratorType>
+	static void encode(SinkType& sink, ForwardIteratorType begin, ForwardIteratorType end) {
+		typedef typename std::iterator_traits<ForwardIteratorType>::value_type::value_type int_type;
+		typedef var_int_value<int_type>                                                    coding_type;
+		typedef typename coding_type::uint_type                                            uint_type;
+
+		uint_type values[var_uint_block_size];
+		byte_type block [var_uint_block_size * max_var_uint_size<uint_type>::value];
+		for (ForwardIteratorType it = begin; it != end; ) {
+			std::size_t n = 0;
+			for (; n < var_uint_block_size && it != end; ++it, ++n)
+				values[n] = coding_type::encode(**it);
+			ostream_operator_interface<SinkType>::write_array(sink, block, encode_var_uints(values, n, block));
+		}
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename IntType>
+	static void decode(source<EncodingEndianness, InputType>& source_, var_int<IntType>* values, unsigned int length) {
+		decode_var_ints<IntType>(source_, values, length);
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename IntType, typename AllocatorType>
+	static void decode(source<EncodingEndianness, InputType>& source_, std::vector<var_int<IntType>, AllocatorType>& values, unsigned int length) {
+		repeated_elements<element_wise_encoding>::reserve_remaining(source_, values, length);
+		std::back_insert_iterator<std::vector<var_int<IntType>, AllocatorType> > iterator(values);
+		decode_var_ints<IntType>(source_, iterator, length);
+	}
+
+private:
+
+	template<typename IntType, endianness EncodingEndianness, typename InputType, typename OutputIteratorType>
+	static void decode_var_ints(source<EncodingEndianness, InputType>& source_, OutputIteratorType iterator, unsigned int length) {
+		typedef istream_operator_interface<source<EncodingEndianness, InputType> > interface_type;
+		typedef var_int_value<IntType>                                  coding_type;
+		typedef typename coding_type::uint_type                         uint_type;
+
+		uint_type values[var_uint_block_size];
+		for (unsigned int i=0; i<length; ) {
+			const std::size_t position  = interface_type::get_position(source_).byte_index;
+			const std::size_t n_block   = length - i < var_uint_block_size ? length - i : var_uint_block_size;
+			const std::size_t n_bytes   = interface_type::request(source_, position, 1) > 0 ? interface_type::available(source_, position) : 0;
+			std::size_t       n_decoded = 0;
+			std::size_t       n_used    = 0;
+			if (n_bytes > 0)
+				n_decoded = decode_var_uints(interface_type::location(source_, position), n_bytes, values, n_block, n_used, max_decodable_var_uint_size<uint_type>::value);
+
+			if (n_decoded == 0) {
+				var_int<IntType> value;
+				read_var_int(source_, *value);
+				*iterator++ = value;
+				++i;
+				continue;
+			}
+			for (std::size_t j=0; j<n_decoded; ++j)
+				*iterator++ = var_int<IntType>(coding_type::decode(values[j]));
+			interface_type::set_position(source_, buffer_position(position + n_used, 7));
+			i += n_decoded;
+		}
+	}
+};
+
+/*
+ * the control bytes are written in a first pass over the elements and the data bytes in a second
+ * one. decoding takes the control bytes and the data bytes they describe as one array, so the
+ * input is checked before anything is decoded
+ */
+template<>
+struct repeated_elements<stream_vbyte_encoding> {
+	template<typename SinkType, typename ForwardIteratorType>
+	static void encode(SinkType& sink, ForwardIteratorType begin, ForwardIteratorType end) {
+		typedef typename std::iterator_traits<ForwardIteratorType>::value_type value_type;
+		typedef ostream_operator_interface<SinkType>                          interface_type;
+
+		SHIFT_STATIC_ASSERT( sizeof(value_type) <= 4
+		                   , stream_vbyte_encodes_integers_of_up_to_4_bytes);
+
+		shift::uint32_t values[var_uint_block_size];
+		byte_type       block [var_uint_block_size * 4];
+		for (ForwardIteratorType it = begin; it != end; ) {
+			const std::size_t n = next_block(it, end, values);
+			interface_type::write_array(sink, block, encode_stream_vbyte_control(values, n, block));
+		}
+		for (ForwardIteratorType it = begin; it != end; ) {
+			const std::size_t n = next_block(it, end, values);
+			interface_type::write_array(sink, block, encode_stream_vbyte_data(values, n, block));
+		}
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename OutputIteratorType>
+	static void decode(source<EncodingEndianness, InputType>& source_, OutputIteratorType& iterator, unsigned int length) {
+		typedef istream_operator_interface<source<EncodingEndianness, InputType> > interface_type;
+		const buffer_position position  = interface_type::get_position(source_);
+		const std::size_t     n_control = stream_vbyte_control_size(length);
+		const std::size_t     n_data    = stream_vbyte_data_size(interface_type::get_array(source_, n_control).first, length);
+		interface_type::set_position(source_, position);
+
+		const byte_type* control  = interface_type::get_array(source_, n_control + n_data).first;
+		const byte_type* data     = control + n_control;
+		const byte_type* data_end = data + n_data;
+
+		shift::uint32_t values[var_uint_block_size];
+		for (std::size_t i=0; i<length; i+=var_uint_block_size) {
+			const std::size_t n = length - i < var_uint_block_size ? length - i : var_uint_block_size;
+			data = decode_stream_vbyte(control + i / 4, data, data_end, values, n);
+			for (std::size_t j=0; j<n; ++j)
+				*iterator++ = values[j];
+		}
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename T, typename AllocatorType>
+	static void decode(source<EncodingEndianness, InputType>& source_, std::back_insert_iterator<std::vector<T, AllocatorType> >& iterator, unsigned int length) {
+		repeated_elements<element_wise_encoding>::reserve_remaining(source_, back_inserted_container<std::vector<T, AllocatorType> >::get(iterator), length);
+		decode<EncodingEndianness, InputType, std::back_insert_iterator<std::vector<T, AllocatorType> > >(source_, iterator, length);
+	}
+
+private:
+
+	template<typename ForwardIteratorType>
+	static std::size_t next_block(ForwardIteratorType& it, ForwardIteratorType end, shift::uint32_t* values) {
+		std::size_t n = 0;
+		for (; n < var_uint_block_size && it != end; ++it, ++n)
+			values[n] = static_cast<shift::uint32_t>(*it);
+		return n;
+	}
+};
+
+/*
+ * the value type of the elements an output iterator assigns to
+ */
+template<typename OutputIteratorType>
+struct output_value_type { typedef typename std::iterator_traits<OutputIteratorType>::value_type type; };
+
+template<typename ContainerType>
+struct output_value_type<std::back_insert_iterator<ContainerType> > { typedef typename ContainerType::value_type type; };
+
+/*
+ * residuals are converted in blocks of var_uint_block_size values and encoded as var uints of the
+ * unsigned type of the element size, without the limit of read_var_uint
+ */
+template<unsigned int Order>
+struct delta_elements {
+	template<typename SinkType, typename ForwardIteratorType>
+	static void encode(SinkType& sink, ForwardIteratorType begin, ForwardIteratorType end) {
+		typedef typename std::iterator_traits<ForwardIteratorType>::value_type value_type;
+		typedef typename uint_of_size<sizeof(value_type)>::type               uint_type;
+
+		SHIFT_STATIC_ASSERT( is_integral<value_type>::value
+		                   , delta_coding_is_defined_for_integral_types);
+
+		uint_type              values   [var_uint_block_size];
+		uint_type              residuals[var_uint_block_size];
+		byte_type              block    [var_uint_block_size * max_var_uint_size<uint_type>::value];
+		delta_state<uint_type> state;
+		for (ForwardIteratorType it = begin; it != end; ) {
+			std::size_t n = 0;
+			for (; n < var_uint_block_size && it != end; ++it, ++n)
+				values[n] = static_cast<uint_type>(*it);
+			encode_deltas<Order>(values, n, state, residuals);
+			ostream_operator_interface<SinkType>::write_array(sink, block, encode_var_uints(residuals, n, block));
+		}
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename OutputIteratorType>
+	static void decode(source<EncodingEndianness, InputType>& source_, OutputIteratorType& iterator, unsigned int length) {
+		typedef typename output_value_type<OutputIteratorType>::type value_type;
+		typedef typename uint_of_size<sizeof(value_type)>::type      uint_type;
+
+		uint_type              values[var_uint_block_size];
+		delta_state<uint_type> state;
+		for (std::size_t i=0; i<length; i+=var_uint_block_size) {
+			const std::size_t n = length - i < var_uint_block_size ? length - i : var_uint_block_size;
+			read_var_uints(source_, values, n, max_var_uint_size<uint_type>::value);
+			decode_deltas<Order>(values, n, state);
+			for (std::size_t j=0; j<n; ++j)
+				*iterator++ = static_cast<value_type>(values[j]);
+		}
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename T, typename AllocatorType>
+	static void decode(source<EncodingEndianness, InputType>& source_, std::back_insert_iterator<std::vector<T, AllocatorType> >& iterator, unsigned int length) {
+		repeated_elements<element_wise_encoding>::reserve_remaining(source_, back_inserted_container<std::vector<T, AllocatorType> >::get(iterator), length);
+		decode<EncodingEndianness, InputType, std::back_insert_iterator<std::vector<T, AllocatorType> > >(source_, iterator, length);
+	}
+};
+
+template<>
+struct repeated_elements<delta_encoding> : delta_elements<1> {};
+
+template<>
+struct repeated_elements<delta_of_delta_encoding> : delta_elements<2> {};
+
+/*
+ * fixed_width_uint elements are packed in blocks of bit_packing_block_size values, which start at
+ * byte boundaries. decoding takes the whole packed array at once
+ */
+template<>
+struct repeated_elements<bit_packed_encoding> {
+	template<typename SinkType, typename ForwardIteratorType>
+	static void encode(SinkType& sink, ForwardIteratorType begin, ForwardIteratorType end) {
+		typedef typename std::iterator_traits<ForwardIteratorType>::value_type value_type;
+		typedef typename packed_value<value_type::num_bits>::type             uint_type;
+
+		uint_type values[bit_packing_block_size];
+		byte_type block [bit_packing_block_size / 8 * value_type::num_bits];
+		for (ForwardIteratorType it = begin; it != end; ) {
+			std::size_t n = 0;
+			for (; n < bit_packing_block_size && it != end; ++it, ++n)
+				values[n] = **it;
+			ostream_operator_interface<SinkType>::write_array(sink, block, pack_bits<value_type::num_bits>(values, n, block));
+		}
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename OutputIteratorType>
+	static void decode(source<EncodingEndianness, InputType>& source_, OutputIteratorType& iterator, unsigned int length) {
+		typedef typename output_value_type<OutputIteratorType>::type value_type;
+		typedef typename value_type::value_type                      int_type;
+		typedef typename packed_value<value_type::num_bits>::type    uint_type;
+
+		const std::size_t n_bytes = packed_size(length, value_type::num_bits);
+		const byte_type*  data    = istream_operator_interface<source<EncodingEndianness, InputType> >::get_array(source_, n_bytes).first;
+		const byte_type*  end     = data + n_bytes;
+
+		uint_type values[bit_packing_block_size];
+		for (std::size_t i=0; i<length; i+=bit_packing_block_size) {
+			const std::size_t n = length - i < bit_packing_block_size ? length - i : bit_packing_block_size;
+			unpack_bits<value_type::num_bits>(data + i / 8 * value_type::num_bits, end, n, values);
+			for (std::size_t j=0; j<n; ++j)
+				*iterator++ = value_type(static_cast<int_type>(values[j]));
+		}
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename T, typename AllocatorType>
+	static void decode(source<EncodingEndianness, InputType>& source_, std::back_insert_iterator<std::vector<T, AllocatorType> >& iterator, unsigned int length) {
+		repeated_elements<element_wise_encoding>::reserve_remaining(source_, back_inserted_container<std::vector<T, AllocatorType> >::get(iterator), length);
+		decode<EncodingEndianness, InputType, std::back_insert_iterator<std::vector<T, AllocatorType> > >(source_, iterator, length);
+	}
+};
+
+/*
+ * each block of frame_of_reference_block_size values is encoded into a local array and written at once
+ */
+template<bool Patched>
+struct frame_of_reference_elements {
+	template<typename SinkType, typename ForwardIteratorType>
+	static void encode(SinkType& sink, ForwardIteratorType begin, ForwardIteratorType end) {
+		typedef typename std::iterator_traits<ForwardIteratorType>::value_type value_type;
+		typedef frame_of_reference_block<value_type>                          block_type;
+
+		SHIFT_STATIC_ASSERT( is_integral<value_type>::value
+		                   , frame_of_reference_coding_is_defined_for_integral_types);
+
+		value_type values[frame_of_reference_block_size];
+		byte_type  block [block_type::max_size];
+		for (ForwardIteratorType it = begin; it != end; ) {
+			std::size_t n = 0;
+			for (; n < frame_of_reference_block_size && it != end; ++it, ++n)
+				values[n] = *it;
+			ostream_operator_interface<SinkType>::write_array(sink, block, block_type::encode(values, n, Patched, block));
+		}
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename OutputIteratorType>
+	static void decode(source<EncodingEndianness, InputType>& source_, OutputIteratorType& iterator, unsigned int length) {
+		typedef typename output_value_type<OutputIteratorType>::type value_type;
+
+		value_type values[frame_of_reference_block_size];
+		for (std::size_t i=0; i<length; i+=frame_of_reference_block_size) {
+			const std::size_t n = length - i < frame_of_reference_block_size ? length - i : frame_of_reference_block_size;
+			frame_of_reference_block<value_type>::decode(source_, values, n, Patched);
+			for (std::size_t j=0; j<n; ++j)
+				*iterator++ = values[j];
+		}
+	}
+
+	template<endianness EncodingEndianness, typename InputType, typename T, typename AllocatorType>
+	static void decode(source<EncodingEndianness, InputType>& source_, std::back_insert_iterator<std::vector<T, AllocatorType> >& iterator, unsigned int length) {
+		repeated_elements<element_wise_encoding>::reserve_remaining(source_, back_inserted_container<std::vector<T, AllocatorType> >::get(iterator), length);
+		decode<EncodingEndianness, InputType, std::back_insert_iterator<std::vector<T, AllocatorType> > >(source_, iterator, length);
+	}
+};
+
+template<>
+struct repeated_elements<frame_of_reference_encoding> : frame_of_reference_elements<false> {};
+
+template<>
+struct repeated_elements<patched_frame_of_reference_encoding> : frame_of_reference_elements<true> {};
+
+template<typename T> struct is_var_int                            { static const bool value = false; };
+template<typename T> struct is_var_int<      var_int<T> >         { static const bool value = true;  };
+template<typename T> struct is_var_int<const var_int<T> >         { static const bool value = true;  };
+
+template<typename T>
+struct element_encoding {
+	static const repeated_element_encoding value = has_plain_encoding<T>::value ? block_encoding
+	                                             : is_var_int<T>::value         ? var_int_block_encoding
+	                                             :                                element_wise_encoding;
+};
+
+/*
+ * pointers are contiguous, var ints are also converted in blocks from other forward iterators
+ */
+template<typename ForwardIteratorType>
+struct iterator_encoding {
+	static const repeated_element_encoding value = is_var_int<typename std::iterator_traits<ForwardIteratorType>::value_type>::value ? var_int_block_encoding : element_wise_encoding;
+};
+
+template<typename T>
+struct iterator_encoding<T*> { static const repeated_element_encoding value = element_encoding<T>::value; };
+
+template<typename OutputIteratorType>
+struct output_iterator_encoding { static const repeated_element_encoding value = element_wise_encoding; };
+
+template<typename T>
+struct output_iterator_encoding<T*> { static const repeated_element_encoding value = element_encoding<T>::value; };
+
+template<typename SourceType, typename OutputIteratorType>
+void decode_repeated(SourceType& source, OutputIteratorType& iterator, unsigned int length) {
+	repeated_elements<output_iterator_encoding<OutputIteratorType>::value>::decode(source, iterator, length);
+}
+
+template<typename SourceType, typename T, typename AllocatorType>
+void decode_repeated(SourceType& source, std::back_insert_iterator<std::vector<T, AllocatorType> >& iterator, unsigned int length) {
+	typedef std::vector<T, AllocatorType> container_type;
+	repeated_elements<element_encoding<T>::value>::decode(source, back_inserted_container<container_type>::get(iterator), length);
+}
+
+/*
+ * the size tag selects the block formats, for other tags the element type decides
+ */
+template<typename SizeType, typename ForwardIteratorType>
+struct repeated_encoding { static const repeated_element_encoding value = iterator_encoding<ForwardIteratorType>::value; };
+
+template<typename ForwardIteratorType>
+struct repeated_encoding<stream_vbyte, ForwardIteratorType> { static const repeated_element_encoding value = stream_vbyte_encoding; };
+
+template<typename ForwardIteratorType>
+struct repeated_encoding<delta_coding, ForwardIteratorType> { static const repeated_element_encoding value = delta_encoding; };
+
+template<typename ForwardIteratorType>
+struct repeated_encoding<delta_of_delta_coding, ForwardIteratorType> { static const repeated_element_encoding value = delta_of_delta_encoding; };
+
+template<typename ForwardIteratorType>
+struct repeated_encoding<bit_packed, ForwardIteratorType> { static const repeated_element_encoding value = bit_packed_encoding; };
+
+template<typename ForwardIteratorType>
+struct repeated_encoding<frame_of_reference, ForwardIteratorType> { static const repeated_element_encoding value = frame_of_reference_encoding; };
+
+template<typename ForwardIteratorType>
+struct repeated_encoding<patched_frame_of_reference, ForwardIteratorType> { static const repeated_element_encoding value = patched_frame_of_reference_encoding; };
+
+template<typename SizeType>
+struct repeated_decoding {
+	template<typename SourceType, typename OutputIteratorType>
+	static void decode(SourceType& source, OutputIteratorType& iterator, unsigned int length) {
+		decode_repeated(source, iterator, length);
+	}
+};
+
+template<>
+struct repeated_decoding<stream_vbyte> : repeated_elements<stream_vbyte_encoding> {};
+
+template<>
+struct repeated_decoding<delta_coding> : repeated_elements<delta_encoding> {};
+
+template<>
+struct repeated_decoding<delta_of_delta_coding> : repeated_elements<delta_of_delta_encoding> {};
+
+template<>
+struct repeated_decoding<bit_packed> : repeated_elements<bit_packed_encoding> {};
+
+template<>
+struct repeated_decoding<frame_of_reference> : repeated_elements<frame_of_reference_encoding> {};
+
+template<>
+struct repeated_decoding<patched_frame_of_reference> : repeated_elements<patched_frame_of_reference_encoding> {};
+
+} // detail
+
 template<typename SizeType, typename ForwardIteratorType>
 class orepeated {
 public:
@@ -34,7 +513,7 @@ private:
 template<endianness EncodingEndianness, typename BufferType, typename ForwardIteratorType, typename SizeType>
 sink<EncodingEndianness, BufferType>& operator << (sink<EncodingEndianness, BufferType>& sink_, const orepeated<SizeType, ForwardIteratorType>& repeated_) {
 	repeated_.encode_size(sink_);
-	for (ForwardIteratorType it = repeated_.begin; it != repeated_.end; ++it) sink_ << *it;
+	detail::repeated_elements<detail::repeated_encoding<SizeType, ForwardIteratorType>::value>::encode(sink_, repeated_.begin, repeated_.end);
 	return sink_;
 }
 
@@ -49,8 +528,8 @@ public:
 	unsigned int& size;
 private:
 	unsigned int size_;
-	template<endianness EncodingEndianness, typename SizeType__, typename OutputIteratorType__>
-	friend source<EncodingEndianness>& operator >> (source<EncodingEndianness>&, irepeated<SizeType__, OutputIteratorType__>);
+	template<endianness EncodingEndianness, typename InputType, typename SizeType__, typename OutputIteratorType__>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>&, irepeated<SizeType__, OutputIteratorType__>);
 
 	template<typename SourceType>
 	unsigned int decode_size(SourceType& source) {
@@ -66,8 +545,8 @@ public:
 	OutputIteratorType iterator;
 	const unsigned int size;
 private:
-	template<endianness EncodingEndianness, typename SizeType__, typename OutputIteratorType__>
-	friend source<EncodingEndianness>& operator >> (source<EncodingEndianness>&, irepeated<SizeType__, OutputIteratorType__>);
+	template<endianness EncodingEndianness, typename InputType, typename SizeType__, typename OutputIteratorType__>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>&, irepeated<SizeType__, OutputIteratorType__>);
 
 	template<typename SourceType>
 	unsigned int decode_size(SourceType& sink) {
@@ -82,8 +561,8 @@ public:
 	OutputIteratorType iterator;
 	static const unsigned int size = Size;
 private:
-	template<endianness EncodingEndianness, typename SizeType__, typename OutputIteratorType__>
-	friend source<EncodingEndianness>& operator >> (source<EncodingEndianness>&, irepeated<SizeType__, OutputIteratorType__>);
+	template<endianness EncodingEndianness, typename InputType, typename SizeType__, typename OutputIteratorType__>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>&, irepeated<SizeType__, OutputIteratorType__>);
 
 	template<typename SourceType>
 	unsigned int decode_size(SourceType& sink) {
@@ -91,8 +570,8 @@ private:
 	}
 };
 
-template<endianness EncodingEndianness, typename ContainerType>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, std::back_insert_iterator<ContainerType>& iterator) {
+template<endianness EncodingEndianness, typename InputType, typename ContainerType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, std::back_insert_iterator<ContainerType>& iterator) {
 	typedef typename std::back_insert_iterator<ContainerType>::container_type::value_type value_type;
 	value_type tmp;
 	source_ >> tmp;
@@ -100,10 +579,10 @@ source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, st
 	return source_;
 }
 
-template<endianness EncodingEndianness, typename SizeType, typename OutputIteratorType>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, irepeated<SizeType, OutputIteratorType> repeated_) {
+template<endianness EncodingEndianness, typename InputType, typename SizeType, typename OutputIteratorType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, irepeated<SizeType, OutputIteratorType> repeated_) {
 	const unsigned int length = repeated_.decode_size(source_);
-	for (unsigned int i=0; i<length; ++i) source_ >> *(repeated_.iterator)++;
+	detail::repeated_decoding<SizeType>::decode(source_, repeated_.iterator, length);
 	return source_;
 }
 
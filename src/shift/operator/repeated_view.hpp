@@ -0,0 +1,246 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_OPERATOR_REPEATED_VIEW_HPP_
+#define SHIFT_OPERATOR_REPEATED_VIEW_HPP_
+
+#include <iterator>
+#include <cstddef>
+
+#include <shift/source.hpp>
+#include <shift/exception.hpp>
+#include <shift/concepts/size_tags.hpp>
+#include <shift/detail/size_encoding.hpp>
+#include <shift/detail/type_traits.hpp>
+#include <shift/detail/static_assert.hpp>
+#include <shift/detail/stream_operator_interface.hpp>
+#include <shift/types/var_int.hpp>
+#include <shift/types/fixed_width_uint.hpp>
+#include <shift/operator/var_int.hpp>
+
+namespace shift {
+
+namespace detail {
+
+/*
+ * the encoded size of elements of a repeated field as written element by element: arithmetic types
+ * and fixed_width_uints have a fixed size, so a field is skipped without looking at its elements;
+ * var ints are skipped by their stop bits
+ */
+template<typename T, bool Plain = has_plain_encoding<T>::value>
+struct view_element {
+	static const bool supported = false;
+};
+
+template<typename T>
+struct fixed_size_view_element {
+	static const bool supported = true;
+
+	template<typename SourceType>
+	static std::size_t encoded_size(SourceType&, unsigned int length) {
+		return length * T::size;
+	}
+
+	template<typename SourceType>
+	static void skip(SourceType& source) {
+		typedef istream_operator_interface<SourceType> interface_type;
+		interface_type::set_position(source, buffer_position(interface_type::get_position(source).byte_index + T::size, 7));
+	}
+};
+
+template<typename T>
+struct view_element<T, true> : fixed_size_view_element<view_element<T, true> > {
+	static const std::size_t size = sizeof(T);
+};
+
+template<typename IntType, unsigned int NumBits>
+struct view_element<fixed_width_uint<IntType, NumBits>, false> : fixed_size_view_element<view_element<fixed_width_uint<IntType, NumBits>, false> > {
+	static const std::size_t size = (NumBits + 7) / 8;
+};
+
+template<typename IntType>
+struct view_element<var_int<IntType>, false> {
+	static const bool supported = true;
+
+	/*
+	 * counts the stop bits of length values. as long as they end beyond the bytes available, one more
+	 * byte is requested for each remaining value, so no byte beyond the field is waited for
+	 */
+	template<typename SourceType>
+	static std::size_t encoded_size(SourceType& source, unsigned int length) {
+		typedef istream_operator_interface<SourceType> interface_type;
+		const std::size_t index    = interface_type::get_position(source).byte_index;
+		std::size_t       n_bytes  = 0;
+		unsigned int      n_values = 0;
+		for (std::size_t n_requested = length; n_values < length; n_requested = n_bytes + (length - n_values)) {
+			const std::size_t n_available = interface_type::request(source, index, n_requested);
+			const byte_type*  p           = interface_type::location(source, index);
+			for (; n_bytes < n_available && n_values < length; ++n_bytes)
+				n_values += (p[n_bytes] & 128) == 0;
+			if (n_values < length && n_available < n_requested)
+				SHIFT_THROW(out_of_range(index + n_available, index, index + n_available));
+		}
+		return n_bytes;
+	}
+
+	template<typename SourceType>
+	static void skip(SourceType& source) {
+		while (istream_operator_interface<SourceType>::get(source) & 128) {}
+	}
+};
+
+} // detail
+
+template<typename SizeType, typename ViewType>
+class irepeated_view;
+
+/*
+ * the elements of an encoded repeated field, decoded one by one as its iterators are dereferenced.
+ * the view refers to the bytes of the field in the buffer of the source it is extracted from, like
+ * string_view, so it is valid for the lifetime of the buffer of sources over memory, but only until
+ * the next extraction from sources with a reader
+ */
+template<typename T, endianness EncodingEndianness>
+class repeated_view {
+public:
+	typedef T value_type;
+
+	class const_iterator {
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef T                         value_type;
+		typedef std::ptrdiff_t            difference_type;
+		typedef const T*                  pointer;
+		typedef const T&                  reference;
+
+		const_iterator() : source_(NULL, 0), index_(0), value_(), decoded_(false) {}
+
+		reference operator* () const { decode(); return  value_; }
+		pointer   operator->() const { decode(); return &value_; }
+
+		const_iterator& operator++() {
+			if (!decoded_)
+				detail::view_element<T>::skip(source_);
+			decoded_ = false;
+			++index_;
+			return *this;
+		}
+
+		const_iterator operator++(int) {
+			const_iterator previous(*this);
+			++*this;
+			return previous;
+		}
+
+		bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+		bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+	private:
+		friend class repeated_view;
+
+		const_iterator(const byte_type* data, std::size_t n_bytes, unsigned int index)
+		: source_(data, n_bytes), index_(index), value_(), decoded_(false) {}
+
+		void decode() const {
+			if (decoded_)
+				return;
+			source_ >> value_;
+			decoded_ = true;
+		}
+
+		mutable source<EncodingEndianness> source_;
+		unsigned int                       index_;
+		mutable T                          value_;
+		mutable bool                       decoded_;
+	};
+
+	typedef const_iterator iterator;
+
+	SHIFT_STATIC_ASSERT( detail::view_element<T>::supported
+	                   , views_are_defined_for_arithmetic_types_fixed_width_uints_and_var_ints);
+
+	repeated_view() : data_(NULL), n_bytes_(0), size_(0) {}
+
+	unsigned int   size () const { return size_; }
+	bool           empty() const { return size_ == 0; }
+
+	const_iterator begin() const { return const_iterator(data_, n_bytes_, 0    ); }
+	const_iterator end  () const { return const_iterator(NULL , 0       , size_); }
+
+private:
+	template<endianness EncodingEndianness__, typename InputType__, typename SizeType__, typename T__>
+	friend source<EncodingEndianness__, InputType__>& operator >> (source<EncodingEndianness__, InputType__>&, const irepeated_view<SizeType__, repeated_view<T__, EncodingEndianness__> >&);
+
+	const byte_type* data_;
+	std::size_t      n_bytes_;
+	unsigned int     size_;
+};
+
+/*
+ * extracts a repeated field with the size type SizeType into a repeated_view. only the size is
+ * decoded and the elements are skipped
+ */
+template<typename SizeType, typename ViewType>
+class irepeated_view {
+public:
+	explicit irepeated_view(ViewType& view) : view(view) {}
+	ViewType& view;
+private:
+	template<endianness EncodingEndianness, typename InputType, typename SizeType__, typename T__>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>&, const irepeated_view<SizeType__, repeated_view<T__, EncodingEndianness> >&);
+
+	template<typename SourceType>
+	unsigned int decode_size(SourceType& source) const {
+		return detail::size_decoder<SizeType>::decode_size(source);
+	}
+};
+
+template<typename ViewType>
+class irepeated_view<no_size_field, ViewType> {
+public:
+	irepeated_view(ViewType& view, unsigned int size) : view(view), size(size) {}
+	ViewType& view;
+	const unsigned int size;
+private:
+	template<endianness EncodingEndianness, typename InputType, typename SizeType__, typename T__>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>&, const irepeated_view<SizeType__, repeated_view<T__, EncodingEndianness> >&);
+
+	template<typename SourceType>
+	unsigned int decode_size(SourceType&) const {
+		return size;
+	}
+};
+
+template<unsigned int Size, typename ViewType>
+class irepeated_view<static_size<Size>, ViewType> {
+public:
+	explicit irepeated_view(ViewType& view) : view(view) {}
+	ViewType& view;
+	static const unsigned int size = Size;
+private:
+	template<endianness EncodingEndianness, typename InputType, typename SizeType__, typename T__>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>&, const irepeated_view<SizeType__, repeated_view<T__, EncodingEndianness> >&);
+
+	template<typename SourceType>
+	unsigned int decode_size(SourceType&) const {
+		return size;
+	}
+};
+
+template<endianness EncodingEndianness, typename InputType, typename SizeType, typename T>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, const irepeated_view<SizeType, repeated_view<T, EncodingEndianness> >& view_) {
+	typedef detail::istream_operator_interface<source<EncodingEndianness, InputType> > interface_type;
+	const unsigned int length  = view_.decode_size(source_);
+	const std::size_t  n_bytes = detail::view_element<T>::encoded_size(source_, length);
+	view_.view.data_    = interface_type::get_array(source_, n_bytes).first;
+	view_.view.n_bytes_ = n_bytes;
+	view_.view.size_    = length;
+	return source_;
+}
+
+} // shift
+
+#endif /* SHIFT_OPERATOR_REPEATED_VIEW_HPP_ */
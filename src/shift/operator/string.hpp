@@ -9,6 +9,7 @@
 
 #include <shift/sink.hpp>
 #include <shift/types/cstdint.hpp>
+#include <shift/types/string_view.hpp>
 #include <shift/detail/size_encoding.hpp>
 
 namespace shift {
@@ -42,14 +43,18 @@ sink<EncodingEndianness, BufferType>& operator << (sink<EncodingEndianness, Buff
 
 ///
 
-template<typename SizeType>
+/*
+ * StringType is std::string or string_view, which refers to the decoded characters in the source
+ * instead of copying them
+ */
+template<typename SizeType, typename StringType = std::string>
 class istring {
 public:
-	explicit istring(std::string& str) : str(str) {}
-	std::string& str;
+	explicit istring(StringType& str) : str(str) {}
+	StringType& str;
 private:
-	template<endianness EncodingEndianness, typename SizeType_>
-	friend source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, const istring<SizeType_>& str_);
+	template<endianness EncodingEndianness, typename InputType, typename SizeType_, typename StringType_>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, const istring<SizeType_, StringType_>& str_);
 
 	template<typename SourceType>
 	unsigned int decode_size(SourceType& source) const {
@@ -57,15 +62,15 @@ private:
 	}
 };
 
-template<>
-class istring<no_size_field> {
+template<typename StringType>
+class istring<no_size_field, StringType> {
 public:
-	istring(std::string& str, unsigned int size) :str(str), size(size) {}
-	std::string& str;
+	istring(StringType& str, unsigned int size) :str(str), size(size) {}
+	StringType& str;
 	const unsigned int size;
 private:
-	template<endianness EncodingEndianness, typename SizeType_>
-	friend source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, const istring<SizeType_>& str_);
+	template<endianness EncodingEndianness, typename InputType, typename SizeType_, typename StringType_>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, const istring<SizeType_, StringType_>& str_);
 
 	template<typename SourceType>
 	unsigned int decode_size(SourceType& sink) const {
@@ -73,15 +78,15 @@ private:
 	}
 };
 
-template<unsigned int Size>
-class istring<static_size<Size> > {
+template<unsigned int Size, typename StringType>
+class istring<static_size<Size>, StringType> {
 public:
-	explicit istring(std::string& str) : str(str) {}
-	std::string& str;
+	explicit istring(StringType& str) : str(str) {}
+	StringType& str;
 	static const unsigned int size = Size;
 private:
-	template<endianness EncodingEndianness, typename SizeType_>
-	friend source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, const istring<SizeType_>& str_);
+	template<endianness EncodingEndianness, typename InputType, typename SizeType_, typename StringType_>
+	friend source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, const istring<SizeType_, StringType_>& str_);
 
 	template<typename SourceType>
 	unsigned int decode_size(SourceType& sink) const {
@@ -89,19 +94,24 @@ private:
 	}
 };
 
-template<endianness EncodingEndianness, typename SizeType>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, const istring<SizeType>& str_) {
+template<endianness EncodingEndianness, typename InputType, typename SizeType, typename StringType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, const istring<SizeType, StringType>& str_) {
 	const unsigned int length = str_.decode_size(source_);
-	std::pair<const shift::byte_type*, const shift::byte_type*> block = detail::istream_operator_interface<source<EncodingEndianness> >::get_array(source_, length);
+	std::pair<const shift::byte_type*, const shift::byte_type*> block = detail::istream_operator_interface<source<EncodingEndianness, InputType> >::get_array(source_, length);
 	str_.str.assign(reinterpret_cast<const char*>(block.first), reinterpret_cast<const char*>(block.second));
 	return source_;
 }
 
-template<endianness EncodingEndianness>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, std::string& str_) {
+template<endianness EncodingEndianness, typename InputType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, std::string& str_) {
 	return source_ >> istring<shift::uint16_t>(str_);
 }
 
+template<endianness EncodingEndianness, typename InputType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, string_view& str_) {
+	return source_ >> istring<shift::uint16_t, string_view>(str_);
+}
+
 }
 
 #endif // SHIFT_OPERATOR_STRING_
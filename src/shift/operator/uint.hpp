@@ -32,8 +32,8 @@ struct iuint {
 	UintType& value;
 };
 
-template<endianness EncodingEndianness, typename UintType, unsigned int NBits>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, const iuint<UintType, NBits>& v) {
+template<endianness EncodingEndianness, typename InputType, typename UintType, unsigned int NBits>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, const iuint<UintType, NBits>& v) {
 	fixed_width_uint<UintType, NBits> tmp;
 	source_ >> tmp;
 	v.value = *tmp;
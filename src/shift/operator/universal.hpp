@@ -17,13 +17,13 @@ sink<EncodingEndianness, BufferType>& operator %(sink<EncodingEndianness, Buffer
 	return sink_ << v;
 }
 
-template<endianness EncodingEndianness, typename T>
-source<EncodingEndianness>& operator %(source<EncodingEndianness>& source_, T& v) {
+template<endianness EncodingEndianness, typename InputType, typename T>
+source<EncodingEndianness, InputType>& operator %(source<EncodingEndianness, InputType>& source_, T& v) {
 	return source_ >> v;
 }
 
-template<endianness EncodingEndianness, typename T>
-source<EncodingEndianness>& operator %(source<EncodingEndianness>& source_, const T& v) {
+template<endianness EncodingEndianness, typename InputType, typename T>
+source<EncodingEndianness, InputType>& operator %(source<EncodingEndianness, InputType>& source_, const T& v) {
 	return source_ >> v;
 }
 
@@ -22,8 +22,8 @@ sink<EncodingEndianness, BufferType>& operator << (sink<EncodingEndianness, Buff
 	return sink_;
 }
 
-template<endianness EncodingEndianness, typename IntType>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, var_int<IntType>& value) {
+template<endianness EncodingEndianness, typename InputType, typename IntType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, var_int<IntType>& value) {
 	detail::read_var_int(source_, *value);
 	return source_;
 }
@@ -48,8 +48,8 @@ sink<EncodingEndianness, BufferType>& operator << (sink<EncodingEndianness, Buff
 	return sink_;
 }
 
-template<endianness EncodingEndianness, typename IntType>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, const ivar_int<IntType>& v) {
+template<endianness EncodingEndianness, typename InputType, typename IntType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, const ivar_int<IntType>& v) {
 	detail::read_var_int(source_, v.value);
 	return source_;
 }
@@ -0,0 +1,51 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_READER_FD_READER_HPP_
+#define SHIFT_READER_FD_READER_HPP_
+
+#include <cerrno>
+#include <cstring>
+#include <cstddef>
+#include <string>
+
+#include <unistd.h>
+
+#include <shift/exception.hpp>
+#include <shift/types/byte.hpp>
+#include <shift/reader/reader.hpp>
+
+namespace shift {
+
+/*
+ * reads from a posix file descriptor, which is not owned
+ */
+class fd_reader : public reader {
+public:
+
+	explicit fd_reader(int fd)
+	: fd_(fd)
+	{
+		if (fd_ < 0) SHIFT_THROW(not_initialized("fd_reader::fd_reader() : invalid file descriptor passed"));
+	}
+
+	std::size_t read(byte_type* p, std::size_t n) {
+		for (;;) {
+			const ssize_t n_read = ::read(fd_, p, n);
+			if (n_read >= 0)
+				return static_cast<std::size_t>(n_read);
+			if (errno != EINTR)
+				SHIFT_THROW(io_error(std::string("fd_reader: read failed: ") + std::strerror(errno), errno));
+		}
+	}
+
+private:
+	int fd_;
+};
+
+} // shift
+
+#endif /* SHIFT_READER_FD_READER_HPP_ */
@@ -0,0 +1,52 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_READER_ISTREAM_READER_HPP_
+#define SHIFT_READER_ISTREAM_READER_HPP_
+
+#include <cstddef>
+#include <istream>
+
+#include <shift/exception.hpp>
+#include <shift/types/byte.hpp>
+#include <shift/reader/reader.hpp>
+
+namespace shift {
+
+/*
+ * reads from a std::istream, which should be opened in binary mode. read() waits for one byte only
+ * and takes the rest from what the stream has buffered, so a stream over a pipe or a socket does
+ * not block while the bytes that were requested are not sent yet
+ */
+class istream_reader : public reader {
+public:
+
+	explicit istream_reader(std::istream& stream)
+	: stream_(stream)
+	{}
+
+	std::size_t read(byte_type* p, std::size_t n) {
+		if (n == 0)
+			return 0;
+		const std::istream::int_type c = stream_.get();
+		if (stream_.bad())
+			SHIFT_THROW(io_error("istream_reader: read failed"));
+		if (std::istream::traits_type::eq_int_type(c, std::istream::traits_type::eof()))
+			return 0;
+		p[0] = static_cast<byte_type>(std::istream::traits_type::to_char_type(c));
+		const std::streamsize n_read = stream_.readsome(reinterpret_cast<char*>(p + 1), static_cast<std::streamsize>(n - 1));
+		if (stream_.bad())
+			SHIFT_THROW(io_error("istream_reader: read failed"));
+		return 1 + static_cast<std::size_t>(n_read);
+	}
+
+private:
+	std::istream& stream_;
+};
+
+} // shift
+
+#endif /* SHIFT_READER_ISTREAM_READER_HPP_ */
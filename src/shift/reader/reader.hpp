@@ -0,0 +1,28 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_READER_READER_HPP_
+#define SHIFT_READER_READER_HPP_
+
+#include <cstddef>
+
+#include <shift/types/byte.hpp>
+
+namespace shift {
+
+/*
+ * data supplier of a streaming source. read() copies up to n bytes to p and returns the number
+ * of bytes copied, 0 at the end of the input.
+ */
+class reader {
+public:
+	virtual ~reader() {}
+	virtual std::size_t read(byte_type* p, std::size_t n) = 0;
+};
+
+} // shift
+
+#endif /* SHIFT_READER_READER_HPP_ */
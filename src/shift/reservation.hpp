@@ -0,0 +1,105 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_RESERVATION_HPP_
+#define SHIFT_RESERVATION_HPP_
+
+#include <cstddef>
+
+#include <shift/sink.hpp>
+#include <shift/buffer/unchecked_buffer.hpp>
+#include <shift/buffer/counting_buffer.hpp>
+#include <shift/detail/stream_operator_interface.hpp>
+
+namespace shift {
+
+/*
+ * reserves n_bytes starting at the current position of a sink with a single bounds check (or resize)
+ * and provides a sink that writes into the reserved range without further checks. on commit() or,
+ * if commit() was not called, on destruction the position and size are handed back to the original
+ * sink. after commit() the original sink may be used again, writes to the reserved range are not
+ * handed back anymore.
+ *
+ * writing beyond the reserved range is undefined; the original sink must not be used while the
+ * reservation is in use.
+ */
+template<typename SinkType>
+class reservation;
+
+template<endianness EncodingEndianness, typename BufferType>
+class reservation<sink<EncodingEndianness, BufferType> > {
+public:
+
+	typedef shift::sink<EncodingEndianness, BufferType>       parent_type;
+	typedef shift::sink<EncodingEndianness, unchecked_buffer> sink_type;
+
+	reservation(parent_type& parent, std::size_t n_bytes)
+	: parent_   (parent)
+	, committed_(false)
+	, sink_(typename sink_type::initialization_params( parent_interface::reserve(parent, n_bytes)
+	                                                 , parent_interface::get_position(parent).byte_index))
+	{
+		sink_interface::set_position(sink_, parent_interface::get_position(parent_));
+		sink_interface::set_size    (sink_, parent_.size());
+	}
+
+	~reservation() {
+		if (!committed_)
+			commit();
+	}
+
+	sink_type& sink() {
+		return sink_;
+	}
+
+	void commit() {
+		parent_interface::set_position(parent_, sink_interface::get_position(sink_));
+		parent_interface::set_size    (parent_, sink_.size());
+		committed_ = true;
+	}
+
+private:
+
+	typedef detail::ostream_operator_interface<parent_type> parent_interface;
+	typedef detail::ostream_operator_interface<sink_type>   sink_interface;
+
+	reservation(const reservation&);
+	reservation& operator=(const reservation&);
+
+	parent_type& parent_;
+	bool         committed_;
+	sink_type    sink_;
+};
+
+/*
+ * a counting sink has no memory to reserve, the reservation writes to the sink itself
+ */
+template<endianness EncodingEndianness>
+class reservation<sink<EncodingEndianness, counting_buffer> > {
+public:
+
+	typedef shift::sink<EncodingEndianness, counting_buffer> parent_type;
+	typedef parent_type                                      sink_type;
+
+	reservation(parent_type& parent, std::size_t) : parent_(parent) {}
+
+	sink_type& sink() {
+		return parent_;
+	}
+
+	void commit() {}
+
+private:
+
+	reservation(const reservation&);
+	reservation& operator=(const reservation&);
+
+	parent_type& parent_;
+};
+
+} // shift
+
+#endif /* SHIFT_RESERVATION_HPP_ */
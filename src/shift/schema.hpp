@@ -0,0 +1,344 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_SCHEMA_HPP_
+#define SHIFT_SCHEMA_HPP_
+
+#include <cstddef>
+
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/buffer/static_buffer.hpp>
+#include <shift/types/fixed_width_uint.hpp>
+#include <shift/detail/type_traits.hpp>
+#include <shift/detail/static_assert.hpp>
+#include <shift/detail/record_words.hpp>
+#include <shift/detail/stream_operator_interface.hpp>
+
+namespace shift {
+
+namespace detail {
+
+/*
+ * the number of bits of field values with a fixed layout: arithmetic types, bools and
+ * fixed_width_uints. other types, like var ints or strings, can't be fields of a schema
+ */
+template<typename T>
+struct field_layout {
+	static const bool         fixed  = has_plain_encoding<T>::value;
+	static const bool         plain  = has_plain_encoding<T>::value;
+	static const unsigned int n_bits = 8 * sizeof(T);
+};
+
+template<>
+struct field_layout<bool> {
+	static const bool         fixed  = true;
+	static const bool         plain  = false;
+	static const unsigned int n_bits = 1;
+};
+
+template<typename IntType, unsigned int NumBits>
+struct field_layout<fixed_width_uint<IntType, NumBits> > {
+	static const bool         fixed  = true;
+	static const bool         plain  = false;
+	static const unsigned int n_bits = NumBits;
+};
+
+/*
+ * the bits of a field from the beginning of the record, the first one is bit Bit of byte Byte
+ */
+template<typename EncodedType, unsigned int Byte, unsigned int Bit>
+struct field_bits {
+	static const unsigned int first_bit  = 8 * Byte + 7 - Bit;
+	static const unsigned int end_bit    = first_bit + field_layout<EncodedType>::n_bits;
+	static const bool         fits_words = record_value<EncodedType>::fits;
+
+	typedef record_bits<first_bit, field_layout<EncodedType>::n_bits> record_bits_type;
+	typedef record_value<EncodedType>                                 record_value_type;
+
+	SHIFT_STATIC_ASSERT(field_layout<EncodedType>::fixed, schema_fields_need_types_of_a_fixed_size);
+	SHIFT_STATIC_ASSERT(Bit <= 7, bit_indices_of_schema_fields_are_0_to_7);
+	SHIFT_STATIC_ASSERT(Bit == 7 || !field_layout<EncodedType>::plain, arithmetic_schema_fields_begin_at_bit_7);
+};
+
+/*
+ * the fields of a schema as a list, with the end of the last field and whether no two fields share a bit
+ */
+struct no_fields {
+	static const unsigned int end_bit    = 0;
+	static const bool         disjoint   = true;
+	static const bool         fits_words = true;
+
+	template<typename SinkType, typename StructType>
+	static void encode(SinkType&, const StructType&) {}
+
+	template<typename SourceType, typename StructType>
+	static void decode(SourceType&, StructType&) {}
+
+	template<endianness EncodingEndianness, typename StructType>
+	static void insert(shift::uint64_t*, const StructType&) {}
+
+	template<endianness EncodingEndianness, typename StructType>
+	static void extract(const shift::uint64_t*, StructType&) {}
+};
+
+template<typename FieldType, typename NextFieldsType>
+struct fields;
+
+template<typename FieldType, typename FieldsType>
+struct disjoint_fields {
+	static const bool value = true;
+};
+
+template<typename FieldType, typename FirstType, typename NextFieldsType>
+struct disjoint_fields<FieldType, fields<FirstType, NextFieldsType> > {
+	static const bool value = (FieldType::end_bit <= FirstType::first_bit || FirstType::end_bit <= FieldType::first_bit)
+	                        && disjoint_fields<FieldType, NextFieldsType>::value;
+};
+
+template<typename FieldType, typename NextFieldsType>
+struct fields {
+	static const unsigned int end_bit    = FieldType::end_bit > NextFieldsType::end_bit ? FieldType::end_bit : NextFieldsType::end_bit;
+	static const bool         disjoint   = disjoint_fields<FieldType, NextFieldsType>::value && NextFieldsType::disjoint;
+	static const bool         fits_words = FieldType::fits_words && NextFieldsType::fits_words;
+
+	template<typename SinkType, typename StructType>
+	static void encode(SinkType& sink, const StructType& value) {
+		FieldType     ::encode(sink, value);
+		NextFieldsType::encode(sink, value);
+	}
+
+	template<typename SourceType, typename StructType>
+	static void decode(SourceType& source, StructType& value) {
+		FieldType     ::decode(source, value);
+		NextFieldsType::decode(source, value);
+	}
+
+	template<endianness EncodingEndianness, typename StructType>
+	static void insert(shift::uint64_t* words, const StructType& value) {
+		FieldType     ::template insert<EncodingEndianness>(words, value);
+		NextFieldsType::template insert<EncodingEndianness>(words, value);
+	}
+
+	template<endianness EncodingEndianness, typename StructType>
+	static void extract(const shift::uint64_t* words, StructType& value) {
+		FieldType     ::template extract<EncodingEndianness>(words, value);
+		NextFieldsType::template extract<EncodingEndianness>(words, value);
+	}
+};
+
+#if __cplusplus >= 201103L
+template<typename... FieldTypes>
+struct make_fields {
+	typedef no_fields type;
+};
+
+template<typename FieldType, typename... FieldTypes>
+struct make_fields<FieldType, FieldTypes...> {
+	typedef fields<FieldType, typename make_fields<FieldTypes...>::type> type;
+};
+#else
+template< typename F1       , typename F2  = void, typename F3  = void, typename F4  = void
+        , typename F5  = void, typename F6  = void, typename F7  = void, typename F8  = void
+        , typename F9  = void, typename F10 = void, typename F11 = void, typename F12 = void
+        , typename F13 = void, typename F14 = void, typename F15 = void, typename F16 = void>
+struct make_fields {
+	typedef fields<F1, typename make_fields<F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12, F13, F14, F15, F16, void>::type> type;
+};
+
+template<>
+struct make_fields<void, void, void, void, void, void, void, void, void, void, void, void, void, void, void, void> {
+	typedef no_fields type;
+};
+#endif
+
+template<typename ConverterType>
+struct default_params {
+	static typename ConverterType::params get() { return typename ConverterType::params(); }
+};
+
+/*
+ * records are encoded into a local buffer field by field, or, if they have at most 16 bytes and
+ * all fields are arithmetic types of 1, 2, 4 or 8 bytes, bools or fixed_width_uints, loaded into
+ * and stored from one or two 64 bit words, from which the fields are extracted with constant
+ * shifts and masks
+ */
+template<typename FieldsType, std::size_t Size, bool InWords = (Size <= max_record_words_size && FieldsType::fits_words)>
+struct record_encoding;
+
+template<typename FieldsType, std::size_t Size>
+struct record_encoding<FieldsType, Size, false> {
+	template<endianness EncodingEndianness, typename BufferType, typename StructType>
+	static void encode(sink<EncodingEndianness, BufferType>& sink_, const StructType& value) {
+		typedef sink<EncodingEndianness, static_buffer<Size> > record_type;
+		record_type     record;
+		const byte_type zeros[Size] = {};
+		ostream_operator_interface<record_type>::write_array(record, zeros, Size);
+		FieldsType::encode(record, value);
+		ostream_operator_interface<sink<EncodingEndianness, BufferType> >::write_array(sink_, record.buffer(), Size);
+	}
+
+	template<endianness EncodingEndianness, typename StructType>
+	static void decode(const byte_type* p, StructType& value) {
+		source<EncodingEndianness> record(p, Size);
+		FieldsType::decode(record, value);
+	}
+};
+
+template<typename FieldsType, std::size_t Size>
+struct record_encoding<FieldsType, Size, true> {
+	template<endianness EncodingEndianness, typename BufferType, typename StructType>
+	static void encode(sink<EncodingEndianness, BufferType>& sink_, const StructType& value) {
+		record_words<Size> record = {};
+		FieldsType::template insert<EncodingEndianness>(record.words, value);
+		byte_type bytes[Size];
+		record.store(bytes);
+		ostream_operator_interface<sink<EncodingEndianness, BufferType> >::write_array(sink_, bytes, Size);
+	}
+
+	template<endianness EncodingEndianness, typename StructType>
+	static void decode(const byte_type* p, StructType& value) {
+		record_words<Size> record;
+		record.load(p);
+		FieldsType::template extract<EncodingEndianness>(record.words, value);
+	}
+};
+
+} // detail
+
+/*
+ * a member of StructType encoded as T at bit Bit of byte Byte of the record
+ */
+template<typename StructType, typename T, T StructType::*Member, unsigned int Byte, unsigned int Bit = 7>
+struct field : detail::field_bits<T, Byte, Bit> {
+	template<typename SinkType>
+	static void encode(SinkType& sink, const StructType& value) {
+		sink << buffer_position(Byte, Bit) << value.*Member;
+	}
+
+	template<typename SourceType>
+	static void decode(SourceType& source, StructType& value) {
+		source >> buffer_position(Byte, Bit) >> value.*Member;
+	}
+
+	template<endianness EncodingEndianness>
+	static void insert(shift::uint64_t* words, const StructType& value) {
+		field::record_bits_type::put(words, field::record_value_type::template to_bits<EncodingEndianness>(value.*Member));
+	}
+
+	template<endianness EncodingEndianness>
+	static void extract(const shift::uint64_t* words, StructType& value) {
+		field::record_value_type::template from_bits<EncodingEndianness>(field::record_bits_type::get(words), value.*Member);
+	}
+};
+
+/*
+ * a member of StructType converted with ConverterType, which has static encode(decoded_type, params)
+ * and decode(encoded_type, params) like the converters in converter.hpp. ParamsType::get() returns
+ * the params, by default the default constructed ones
+ */
+template< typename     ConverterType
+        , typename     StructType
+        , typename     ConverterType::decoded_type StructType::*Member
+        , unsigned int Byte
+        , unsigned int Bit        = 7
+        , typename     ParamsType = detail::default_params<ConverterType> >
+struct converted_field : detail::field_bits<typename ConverterType::encoded_type, Byte, Bit> {
+	template<typename SinkType>
+	static void encode(SinkType& sink, const StructType& value) {
+		sink << buffer_position(Byte, Bit) << ConverterType::encode(value.*Member, ParamsType::get());
+	}
+
+	template<typename SourceType>
+	static void decode(SourceType& source, StructType& value) {
+		typename ConverterType::encoded_type encoded;
+		source >> buffer_position(Byte, Bit) >> encoded;
+		value.*Member = ConverterType::decode(encoded, ParamsType::get());
+	}
+
+	template<endianness EncodingEndianness>
+	static void insert(shift::uint64_t* words, const StructType& value) {
+		const typename ConverterType::encoded_type encoded = ConverterType::encode(value.*Member, ParamsType::get());
+		converted_field::record_bits_type::put(words, converted_field::record_value_type::template to_bits<EncodingEndianness>(encoded));
+	}
+
+	template<endianness EncodingEndianness>
+	static void extract(const shift::uint64_t* words, StructType& value) {
+		typename ConverterType::encoded_type encoded;
+		converted_field::record_value_type::template from_bits<EncodingEndianness>(converted_field::record_bits_type::get(words), encoded);
+		value.*Member = ConverterType::decode(encoded, ParamsType::get());
+	}
+};
+
+/*
+ * the layout of a record of StructType, given by its fields with their positions relative to the
+ * beginning of the record. the fields are checked not to overlap at compile time. a record has size
+ * bytes: it is encoded into a local buffer, which is written to the sink at once, and decoded from
+ * size bytes extracted from the source at once, so the bounds of the input are checked once per
+ * record. bytes of the record that no field covers are written as zeros. records of up to 16 bytes
+ * of arithmetic types, bools and fixed_width_uints are held in one or two 64 bit words instead, the
+ * fields are inserted and extracted with constant shifts and masks, or pdep and pext with BMI2.
+ *
+ * with C++11 a schema has any number of fields, otherwise up to 16.
+ */
+#if __cplusplus >= 201103L
+template<typename StructType, typename... FieldTypes>
+class schema {
+	typedef typename detail::make_fields<FieldTypes...>::type fields_type;
+#else
+template< typename StructType
+        , typename F1       , typename F2  = void, typename F3  = void, typename F4  = void
+        , typename F5  = void, typename F6  = void, typename F7  = void, typename F8  = void
+        , typename F9  = void, typename F10 = void, typename F11 = void, typename F12 = void
+        , typename F13 = void, typename F14 = void, typename F15 = void, typename F16 = void>
+class schema {
+	typedef typename detail::make_fields<F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12, F13, F14, F15, F16>::type fields_type;
+#endif
+
+public:
+	typedef StructType value_type;
+
+	static const std::size_t size = (fields_type::end_bit + 7) / 8;
+
+	SHIFT_STATIC_ASSERT((fields_type::end_bit > 0), schemas_have_fields);
+	SHIFT_STATIC_ASSERT(fields_type::disjoint   , schema_fields_do_not_overlap);
+
+	template<endianness EncodingEndianness, typename BufferType>
+	static sink<EncodingEndianness, BufferType>& encode(sink<EncodingEndianness, BufferType>& sink_, const StructType& value) {
+		detail::record_encoding<fields_type, size>::encode(sink_, value);
+		return sink_;
+	}
+
+	template<endianness EncodingEndianness, typename InputType>
+	static source<EncodingEndianness, InputType>& decode(source<EncodingEndianness, InputType>& source_, StructType& value) {
+		typedef detail::istream_operator_interface<source<EncodingEndianness, InputType> > interface_type;
+		detail::record_encoding<fields_type, size>::template decode<EncodingEndianness>(interface_type::get_array(source_, size).first, value);
+		return source_;
+	}
+
+	/*
+	 * moves past a record, throws out_of_range if it is not complete
+	 */
+	template<endianness EncodingEndianness, typename InputType>
+	static source<EncodingEndianness, InputType>& skip(source<EncodingEndianness, InputType>& source_) {
+		detail::istream_operator_interface<source<EncodingEndianness, InputType> >::get_array(source_, size);
+		return source_;
+	}
+
+	/*
+	 * whether a complete record follows the current position, without extracting it
+	 */
+	template<endianness EncodingEndianness, typename InputType>
+	static bool validate(source<EncodingEndianness, InputType>& source_) {
+		typedef detail::istream_operator_interface<source<EncodingEndianness, InputType> > interface_type;
+		const std::size_t index = interface_type::get_position(source_).byte_index;
+		return interface_type::request(source_, index, size) >= size;
+	}
+};
+
+} // shift
+
+#endif /* SHIFT_SCHEMA_HPP_ */
@@ -8,12 +8,15 @@
 #define SHIFT_SINK_HPP_
 
 #include <shift/stream_buffer.hpp>
+#include <shift/bit_writer.hpp>
 #include <shift/types/fixed_width_uint.hpp>
 #include <shift/types/cstdint.hpp>
 #include <shift/detail/stream_operator_interface.hpp>
 #include <shift/detail/size_encoding.hpp>
 #include <shift/detail/utility.hpp>
 #include <shift/detail/endian_reversal.hpp>
+#include <shift/detail/byte_swap.hpp>
+#include <shift/detail/buffer_traits.hpp>
 
 namespace shift {
 
@@ -28,18 +31,17 @@ public:
 	: base_type()
 	, size_()
 	, buffer_(init_params)
-	, block_write_func_(get_block_write_func())
 	{
 	}
 
 	void clear() {
 		buffer_.clear();
 		base_type::current_position_.byte_index = 0;
-		base_type::current_position_.bit_index  = 0;
+		base_type::current_position_.bit_index  = 7;
 		size_                                   = 0;
 	}
 
-	unsigned int size() const {
+	std::size_t size() const {
 		return size_;
 	}
 
@@ -53,14 +55,9 @@ private:
 	template<typename SinkType>
 	friend struct detail::ostream_operator_interface;
 
-	typedef std::size_t (buffer_type::*block_write_func_type) (const byte_type*, std::size_t, std::size_t);
+	typedef detail::block_copy<detail::requires_endianness_conversion<EncodingEndianness>::value> block_copy_type;
 
-	static block_write_func_type get_block_write_func() {
-		if (base_type::requires_endianness_conversion())
-			return &buffer_type::reverse_write;
-		else
-			return &buffer_type::write;
-	}
+	static const std::size_t conversion_block_size = 512;
 
 	static inline byte_type inverse_bits(byte_type v) {
 		return ~v;
@@ -74,27 +71,14 @@ private:
 
 	template<typename IntType, unsigned int NumBits>
 	void write_bits(const IntType v) {
-		const IntType value = base_type::requires_endianness_conversion() ? detail::endian_reverse(v) : v;
-		unsigned int n_bits = NumBits;
-		while(n_bits > 0){
-			if (n_bits > base_type::current_position_.bit_index+1) {
-				const unsigned int n_bits_to_encode = base_type::current_position_.bit_index + 1;
-				const unsigned int n_shifts         = n_bits - n_bits_to_encode;
-				const byte_type byte_value          = (buffer_.at(base_type::current_position_.byte_index) & inverse_bits(detail::bit_mask::get(n_bits_to_encode))) | (value >> n_shifts);
-				write(byte_value);
-				n_bits -= n_bits_to_encode;
-			} else {
-				const unsigned int n_shifts = (base_type::current_position_.bit_index + 1) - n_bits;
-				const byte_type byte_value  = (buffer_.at(base_type::current_position_.byte_index) & (inverse_bits(detail::bit_mask::get(n_bits) << n_shifts))) | (value << n_shifts);
-				write(byte_value);
-				n_bits = 0;
-			}
-			base_type::current_position_.bit_index  = 7;
-		}
+		bit_writer<sink> writer(*this);
+		writer.write(fixed_width_uint<IntType, NumBits>(v));
+		writer.flush();
 	}
 
 	void write(bool value) {
-		const byte_type byte_value = (buffer_.at(base_type::current_position_.byte_index) & inverse_bits(1 << base_type::current_position_.bit_index)) | ((value & 1) << base_type::current_position_.bit_index);
+		const byte_type current    = base_type::current_position_.byte_index < size_ ? buffer_.at(base_type::current_position_.byte_index) : 0;
+		const byte_type byte_value = (current & inverse_bits(1 << base_type::current_position_.bit_index)) | ((value & 1) << base_type::current_position_.bit_index);
 		write(byte_value);
 	}
 
@@ -103,11 +87,41 @@ private:
 	 */
 	void write_block(const byte_type* p, const std::size_t n) {
 
-		base_type::current_position_.byte_index = (buffer_.*block_write_func_)(p, base_type::current_position_.byte_index, n);
+		base_type::current_position_.byte_index = block_copy_type::write(buffer_, p, base_type::current_position_.byte_index, n);
 		base_type::current_position_.bit_index  = 7;
 		update_size();
 	}
 
+	/*
+	 * considering endianness, for arithmetic types of 1, 2, 4 or 8 bytes
+	 */
+	template<typename T>
+	void write_value(const T value) {
+		const T encoded = detail::convert_byte_order<EncodingEndianness>(value);
+		write_array(reinterpret_cast<const byte_type*>(&encoded), sizeof(T));
+	}
+
+	/*
+	 * considering endianness, for arrays of arithmetic types of 1, 2, 4 or 8 bytes. values that need
+	 * to be converted are passed to the buffer in blocks, unless the buffer only counts them
+	 */
+	template<typename T>
+	void write_values(const T* values, const std::size_t n) {
+		if (n == 0)
+			return;
+		if (!detail::requires_endianness_conversion<EncodingEndianness>::value || detail::is_counting_buffer<BufferType>::value) {
+			write_array(reinterpret_cast<const byte_type*>(values), n * sizeof(T));
+			return;
+		}
+		byte_type block[conversion_block_size];
+		const std::size_t n_per_block = conversion_block_size / sizeof(T);
+		for (std::size_t i=0; i<n; i+=n_per_block) {
+			const std::size_t n_block = n - i < n_per_block ? n - i : n_per_block;
+			detail::encode_values<EncodingEndianness>(values + i, n_block, block);
+			write_array(block, n_block * sizeof(T));
+		}
+	}
+
 	/*
 	 * endianess is not considered
 	 */
@@ -117,13 +131,24 @@ private:
 		update_size();
 	}
 
+	byte_type read(const std::size_t index) {
+		return buffer_.at(index);
+	}
+
+	byte_type* reserve(const std::size_t n_bytes) {
+		return buffer_.reserve(base_type::current_position_.byte_index, base_type::current_position_.byte_index + n_bytes);
+	}
+
+	void set_size(const std::size_t size) {
+		size_ = size;
+	}
+
 	void update_size() {
 		size_ = base_type::current_position_.byte_index > size_ ? base_type::current_position_.byte_index : size_;
 	}
 
-	unsigned int          size_;
-	buffer_type           buffer_;
-	block_write_func_type block_write_func_;
+	std::size_t size_;
+	buffer_type buffer_;
 };
 
 template<endianness EncodingEndianness, typename BufferType>
@@ -155,10 +180,7 @@ sink<EncodingEndianness, BufferType>& operator << (sink<EncodingEndianness, Buff
 	template<endianness EncodingEndianness, typename BufferType>                                                  \
 	sink<EncodingEndianness, BufferType>& operator << (sink<EncodingEndianness, BufferType>& sink_, type value) { \
 		typedef sink<EncodingEndianness, BufferType> sink_type;                                                   \
-		detail::ostream_operator_interface<sink_type>::write_block( sink_                                         \
-		                                                          , reinterpret_cast<const byte_type*>(&value)    \
-		                                                          , sizeof(type));                                \
-		return sink_;                                                                                             \
+		return detail::ostream_operator_interface<sink_type>::write_value(sink_, value);                          \
 	}                                                                                                             \
 
 DEFINE_SHIFT_INSERT_OPERATOR_BASIC_TYPE(shift::int8_t  )
@@ -8,8 +8,12 @@
 #define SHIFT_SOURCE_HPP_
 
 #include <utility>
+#include <cstring>
+#include <cstddef>
 
 #include <shift/stream_buffer.hpp>
+#include <shift/bit_reader.hpp>
+#include <shift/reader/reader.hpp>
 #include <shift/types/byte.hpp>
 #include <shift/exception.hpp>
 #include <shift/types/fixed_width_uint.hpp>
@@ -19,17 +23,71 @@
 
 namespace shift {
 
-template<endianness EncodingEndianness>
-class source : public stream_buffer<EncodingEndianness, input> {
+/*
+ * the input of a source over a buffer in memory
+ */
+class memory_input {
 public:
 
-	source(const byte_type* buffer, unsigned int size )
-	: buffer_(buffer)
+	memory_input(const byte_type* buffer, std::size_t size)
+	: data_(buffer)
 	, size_(size)
-	, block_read_func_(get_block_read_func())
 	{}
 
-	unsigned int size() const { return size_; }
+	std::size_t size() const { return size_; }
+
+	/*
+	 * returns the location of [index, index + n), throws out_of_range if the buffer ends before
+	 */
+	const byte_type* fetch(std::size_t index, std::size_t n) {
+		if (index + n > size_)
+			SHIFT_THROW(out_of_range(index + n - 1, 0, size_));
+		return data_ + index;
+	}
+
+	/*
+	 * returns the number of bytes of [index, index + n) that are in the buffer
+	 */
+	std::size_t request(std::size_t index, std::size_t n) {
+		const std::size_t n_available = available(index);
+		return n_available < n ? n_available : n;
+	}
+
+	std::size_t available(std::size_t index) const {
+		return index < size_ ? size_ - index : 0;
+	}
+
+	const byte_type* location(std::size_t index) const {
+		return data_ + index;
+	}
+
+private:
+	const byte_type* data_;
+	std::size_t      size_;
+};
+
+/*
+ * decodes from the bytes of an InputType, by default a buffer in memory. size() is the end of the
+ * data that is available so far. a source over memory is a plain value that can be copied;
+ * streaming_source decodes the input of a reader.
+ */
+template<endianness EncodingEndianness, typename InputType = memory_input>
+class source : public stream_buffer<EncodingEndianness, input> {
+public:
+
+	typedef InputType input_type;
+
+	source(const byte_type* buffer, std::size_t size)
+	: input_(buffer, size)
+	{}
+
+	std::size_t size() const { return input_.size(); }
+
+protected:
+
+	source(reader& data_reader, std::size_t window_capacity)
+	: input_(data_reader, window_capacity)
+	{}
 
 private:
 
@@ -38,107 +96,110 @@ private:
 	template<typename SourceType>
 	friend struct detail::istream_operator_interface;
 
-	typedef byte_type* (*block_read_func_type) (const byte_type*, const byte_type*, byte_type*);
-
-	static block_read_func_type get_block_read_func() {
-		if(base_type::requires_endianness_conversion())
-			return &detail::reverse_copy<const byte_type*, byte_type*>;
-		else
-			return &std::copy<const byte_type*, byte_type*>;
-	}
+	typedef detail::block_copy<detail::requires_endianness_conversion<EncodingEndianness>::value> block_copy_type;
 
 	byte_type get() {
-		SHIFT_THROW_ON_INDEX_OUT_OF_RANGE(base_type::current_position_.byte_index, 0, size_);
+		const byte_type value = *fetch(base_type::current_position_.byte_index, 1);
+		++base_type::current_position_.byte_index;
 		base_type::current_position_.bit_index = 7;
-		return buffer_[base_type::current_position_.byte_index++];
+		return value;
 	}
 
 	void get(bool& value) {
-		SHIFT_THROW_ON_INDEX_OUT_OF_RANGE(base_type::current_position_.byte_index, 0, size_);
-		value = buffer_[base_type::current_position_.byte_index++] & (1 << base_type::current_position_.bit_index);
+		value = *fetch(base_type::current_position_.byte_index, 1) & (1 << base_type::current_position_.bit_index);
+		++base_type::current_position_.byte_index;
 		base_type::current_position_.bit_index   = 7;
 	}
 
 	/*
 	 * consider endianess
 	 */
-	void get_block(byte_type* data, unsigned int n_bytes) {
-		SHIFT_THROW_ON_INDEX_OUT_OF_RANGE(base_type::current_position_.byte_index + n_bytes - 1, 0, size_);
-		(*block_read_func_)( buffer_ + base_type::current_position_.byte_index
-		                   , buffer_ + base_type::current_position_.byte_index + n_bytes
-		                   , data);
+	void get_block(byte_type* data, std::size_t n_bytes) {
+		const byte_type* p = fetch(base_type::current_position_.byte_index, n_bytes);
+		block_copy_type::read(p, p + n_bytes, data);
 		base_type::current_position_.byte_index += n_bytes;
 		base_type::current_position_.bit_index   = 7;
 	}
 
 	/*
-	 * endianess is not considered
+	 * consider endianess, for arithmetic types of 1, 2, 4 or 8 bytes
+	 */
+	template<typename T>
+	void get_value(T& value) {
+		T encoded;
+		std::memcpy(&encoded, fetch(base_type::current_position_.byte_index, sizeof(T)), sizeof(T));
+		value = detail::convert_byte_order<EncodingEndianness>(encoded);
+		base_type::current_position_.byte_index += sizeof(T);
+		base_type::current_position_.bit_index   = 7;
+	}
+
+	/*
+	 * endianess is not considered. the range is valid until the next extraction
 	 */
-	std::pair<const byte_type*, const byte_type*> get_array(unsigned int n_bytes) {
-		SHIFT_THROW_ON_INDEX_OUT_OF_RANGE(base_type::current_position_.byte_index + n_bytes - 1, 0, size_);
-		const unsigned int current_pos = base_type::current_position_.byte_index;
+	std::pair<const byte_type*, const byte_type*> get_array(std::size_t n_bytes) {
+		const byte_type* p = fetch(base_type::current_position_.byte_index, n_bytes);
 		base_type::current_position_.byte_index += n_bytes;
 		base_type::current_position_.bit_index   = 7;
-		return std::make_pair( buffer_ + current_pos
-		                     , buffer_ + current_pos + n_bytes);
+		return std::make_pair(p, p + n_bytes);
 	}
 
 	template<typename IntType, unsigned int NumBits>
 	IntType get_bits(){
-		IntType result = 0;
-		unsigned int n_bits = NumBits;
-		while(n_bits > 0){
-			if (n_bits > base_type::current_position_.bit_index + 1) {
-				const unsigned int n_bits_to_decode = base_type::current_position_.bit_index + 1;
-				const unsigned int n_shifts         = n_bits - n_bits_to_decode;
-				result = result | static_cast<IntType>((get() & detail::bit_mask::get(n_bits_to_decode))) << n_shifts;
-				n_bits -= n_bits_to_decode;
-			} else {
-				const unsigned int n_shifts = (base_type::current_position_.bit_index + 1) - n_bits;
-				result = result | static_cast<IntType>(((get() >> n_shifts) & detail::bit_mask::get(n_bits)));
-				n_bits  = 0;
-			}
-			base_type::current_position_.bit_index = 7;
-		}
-		return base_type::requires_endianness_conversion() ? detail::endian_reverse(result) : result;
+		bit_reader<source> reader(*this);
+		const IntType result = reader.template read<IntType, NumBits>();
+		reader.align();
+		return result;
+	}
+
+	const byte_type* fetch(std::size_t index, std::size_t n) {
+		return input_.fetch(index, n);
+	}
+
+	std::size_t request(std::size_t index, std::size_t n) {
+		return input_.request(index, n);
+	}
+
+	std::size_t available(std::size_t index) const {
+		return input_.available(index);
+	}
+
+	const byte_type* location(std::size_t index) const {
+		return input_.location(index);
 	}
 
-	const byte_type*     buffer_;
-	unsigned int         size_;
-	block_read_func_type block_read_func_;
+	input_type input_;
 };
 
-template<endianness EncodingEndianness>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, const buffer_position& pos) {
+template<endianness EncodingEndianness, typename InputType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, const buffer_position& pos) {
 	typedef stream_buffer<EncodingEndianness, input> stream_type;
 	detail::stream_operator_interface<stream_type>::set_position(source_, pos);
 	return source_;
 }
 
-template<endianness EncodingEndianness, typename IntType, unsigned int NumBits>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, fixed_width_uint<IntType, NumBits>& value) {
-	detail::istream_operator_interface<source<EncodingEndianness> >::get(source_, value);
+template<endianness EncodingEndianness, typename InputType, typename IntType, unsigned int NumBits>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, fixed_width_uint<IntType, NumBits>& value) {
+	detail::istream_operator_interface<source<EncodingEndianness, InputType> >::get(source_, value);
 	return source_;
 }
 
-template<endianness EncodingEndianness>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, typename shift::byte_type& ref) {
-	ref = detail::istream_operator_interface<source<EncodingEndianness> >::get(source_);
+template<endianness EncodingEndianness, typename InputType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, typename shift::byte_type& ref) {
+	ref = detail::istream_operator_interface<source<EncodingEndianness, InputType> >::get(source_);
 	return source_;
 }
 
-template<endianness EncodingEndianness>
-source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, bool& value) {
-	detail::istream_operator_interface<source<EncodingEndianness> >::get(source_, value);
+template<endianness EncodingEndianness, typename InputType>
+source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, bool& value) {
+	detail::istream_operator_interface<source<EncodingEndianness, InputType> >::get(source_, value);
 	return source_;
 }
 
 #define DEFINE_SHIFT_EXTRACT_OPERATOR_BASIC_TYPE(type)                                                                                     \
-	template<endianness EncodingEndianness>                                                                                                \
-	source<EncodingEndianness>& operator >> (source<EncodingEndianness>& source_, type& ref) {                                             \
-	typedef shift::byte_type byte_type;                                                                                                    \
-	detail::istream_operator_interface<source<EncodingEndianness> >::get_block(source_, reinterpret_cast<byte_type*>(&ref), sizeof(type)); \
-	return source_;                                                                                                                        \
+	template<endianness EncodingEndianness, typename InputType>                                                                               \
+	source<EncodingEndianness, InputType>& operator >> (source<EncodingEndianness, InputType>& source_, type& ref) {                          \
+	detail::istream_operator_interface<source<EncodingEndianness, InputType> >::get_value(source_, ref);                                      \
+	return source_;                                                                                                                           \
 }
 
 DEFINE_SHIFT_EXTRACT_OPERATOR_BASIC_TYPE(shift::int8_t  )
@@ -22,8 +22,7 @@ public:
 	typedef Mode mode;
 
 	static endianness endianness_type()                { return EncodingEndianness; }
-	static bool       requires_endianness_conversion() { static const bool result = ! (endianness_type() == detail::endianness_impl::system_endianness());
-	                                                     return result;                                                                              }
+	static bool       requires_endianness_conversion() { return detail::requires_endianness_conversion<EncodingEndianness>::value; }
 
 protected:
 	template<typename StreamType>
@@ -0,0 +1,158 @@
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_STREAMING_SOURCE_HPP_
+#define SHIFT_STREAMING_SOURCE_HPP_
+
+#include <cstring>
+#include <cstddef>
+#include <vector>
+
+#include <shift/source.hpp>
+#include <shift/reader/reader.hpp>
+#include <shift/types/byte.hpp>
+#include <shift/exception.hpp>
+
+namespace shift {
+
+/*
+ * the input of a streaming_source: a sliding window over the data of a reader that is refilled on
+ * demand. the window starts at the first byte of the field being decoded and grows to the size of
+ * the largest field; positions before it cannot be read anymore.
+ */
+class reader_input {
+public:
+
+	reader_input(reader& data_reader, std::size_t window_capacity)
+	: window_ (NULL)
+	, offset_ (0)
+	, end_    (0)
+	, reader_ (data_reader)
+	, storage_(window_capacity > 0 ? window_capacity : 1)
+	{
+		window_ = &storage_[0];
+	}
+
+	std::size_t size() const { return end_; }
+
+	/*
+	 * makes [index, index + n) available and returns its location, throws out_of_range if the input ends before
+	 */
+	const byte_type* fetch(std::size_t index, std::size_t n) {
+		if (index < offset_ || index + n > end_) {
+			refill(index, n);
+			if (index < offset_ || index + n > end_)
+				SHIFT_THROW(out_of_range(index + n - 1, offset_, end_));
+		}
+		return window_ + (index - offset_);
+	}
+
+	/*
+	 * tries to make [index, index + n) available, returns the number of bytes available from index (at most n)
+	 */
+	std::size_t request(std::size_t index, std::size_t n) {
+		if (index < offset_ || index + n > end_)
+			refill(index, n);
+		if (index < offset_ || index >= end_)
+			return 0;
+		return end_ - index < n ? end_ - index : n;
+	}
+
+	/*
+	 * number of bytes from index that are in the window, without reading from the reader
+	 */
+	std::size_t available(std::size_t index) const {
+		return index >= offset_ && index < end_ ? end_ - index : 0;
+	}
+
+	const byte_type* location(std::size_t index) const {
+		return window_ + (index - offset_);
+	}
+
+private:
+
+	reader_input(const reader_input&);
+	reader_input& operator=(const reader_input&);
+
+	/*
+	 * moves the window to index, keeping the bytes after it, and reads until n bytes are available
+	 * or the input ends
+	 */
+	void refill(std::size_t index, std::size_t n) {
+		if (index < offset_)
+			return;
+
+		std::size_t n_kept = 0;
+		if (index < end_) {
+			n_kept = end_ - index;
+			std::memmove(&storage_[0], window_ + (index - offset_), n_kept);
+		} else if (!skip(index - end_)) {
+			return;
+		}
+
+		if (storage_.size() < n)
+			storage_.resize(n);
+		window_ = &storage_[0];
+		offset_ = index;
+		end_    = index + n_kept;
+
+		while (end_ - offset_ < n) {
+			const std::size_t n_read = reader_.read(&storage_[end_ - offset_], storage_.size() - (end_ - offset_));
+			if (n_read == 0)
+				break;
+			end_ += n_read;
+		}
+	}
+
+	/*
+	 * discards the next n bytes of the input, returns false if it ends before
+	 */
+	bool skip(std::size_t n) {
+		while (n > 0) {
+			const std::size_t n_read = reader_.read(&storage_[0], n < storage_.size() ? n : storage_.size());
+			if (n_read == 0) {
+				offset_ = end_;
+				return false;
+			}
+			end_ += n_read;
+			n    -= n_read;
+		}
+		offset_ = end_;
+		return true;
+	}
+
+	const byte_type*       window_;
+	std::size_t            offset_;
+	std::size_t            end_;
+	reader&                reader_;
+	std::vector<byte_type> storage_;
+};
+
+/*
+ * decodes the data of a reader, which is not owned, for inputs that do not fit into memory. the
+ * extraction operators of source apply. a streaming_source cannot be copied, copies would share
+ * the reader and take its data from each other.
+ */
+template<endianness EncodingEndianness>
+class streaming_source : public source<EncodingEndianness, reader_input> {
+public:
+
+	static const std::size_t default_window_capacity = 64 * 1024;
+
+	explicit streaming_source(reader& data_reader, std::size_t window_capacity = default_window_capacity)
+	: base_type(data_reader, window_capacity)
+	{}
+
+private:
+
+	typedef source<EncodingEndianness, reader_input> base_type;
+
+	streaming_source(const streaming_source&);
+	streaming_source& operator=(const streaming_source&);
+};
+
+} // shift
+
+#endif /* SHIFT_STREAMING_SOURCE_HPP_ */
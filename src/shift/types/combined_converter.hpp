@@ -1,4 +1,3 @@
-
 //          Copyright Michael Mehling 2016.
 // Distributed under the Boost Software License, Version 1.0.
 //    (See accompanying file LICENSE_1_0.txt or copy at
@@ -11,195 +10,182 @@
 
 namespace shift {
 
-template<typename C1, typename C2, typename C3 = void, typename C4 = void, typename C5 = void>
-class combined_converter;
+namespace detail {
 
-template<typename C1, typename C2>
-class combined_converter<C1, C2, void, void, void> : public converter<typename C1::decoded_type, typename C2::encoded_type>{
-public:
-	typedef C1                                 converter_1;
-	typedef C2                                 converter_2;
-	typedef typename converter_1::decoded_type decoded_type;
-	typedef typename converter_2::encoded_type encoded_type;
-
-	combined_converter(decoded_type& value, typename C1::params p1, typename C2::params p2)
-	: conv2_result()
-	, c1(value       , p1)
-	, c2(conv2_result, p2)
-	{}
+/*
+ * the stages of a combined converter from ConverterType on: the params of each stage, of which the
+ * intermediate values are passed from stage to stage as arguments and return values
+ */
+template<typename ConverterType, typename NextStages>
+struct converter_stages {
+	typedef typename ConverterType::decoded_type decoded_type;
+	typedef typename NextStages::encoded_type    encoded_type;
 
-	encoded_type encode()                 const { conv2_result = c1.encode(); return c2.encode(); }
-	void         decode(encoded_type arg) const { c2.decode(arg); c1.decode(conv2_result);        }
+#if __cplusplus >= 201103L
+	template<typename... ParamsTypes>
+	converter_stages(const typename ConverterType::params& p, const ParamsTypes&... next_p) : p(p), next(next_p...) {}
+#else
+	template<typename P2>
+	converter_stages(const typename ConverterType::params& p, const P2& p2) : p(p), next(p2) {}
 
-private:
+	template<typename P2, typename P3>
+	converter_stages(const typename ConverterType::params& p, const P2& p2, const P3& p3) : p(p), next(p2, p3) {}
+
+	template<typename P2, typename P3, typename P4>
+	converter_stages(const typename ConverterType::params& p, const P2& p2, const P3& p3, const P4& p4) : p(p), next(p2, p3, p4) {}
 
-	typedef typename converter_2::decoded_type conv2_result_type;
+	template<typename P2, typename P3, typename P4, typename P5>
+	converter_stages(const typename ConverterType::params& p, const P2& p2, const P3& p3, const P4& p4, const P5& p5) : p(p), next(p2, p3, p4, p5) {}
+#endif
 
-	mutable conv2_result_type conv2_result;
+	encoded_type encode(decoded_type value) const { return next.encode(ConverterType::encode(value, p)); }
+	decoded_type decode(encoded_type arg  ) const { return ConverterType::decode(next.decode(arg), p); }
 
-	converter_1 c1;
-	converter_2 c2;
+	typename ConverterType::params p;
+	NextStages                     next;
 };
 
-template<typename C1, typename C2, typename C3>
-class combined_converter<C1, C2, C3, void, void> : public converter<typename C1::decoded_type, typename C3::encoded_type>{
-public:
-	typedef C1                                 converter_1;
-	typedef C2                                 converter_2;
-	typedef C3                                 converter_3;
-	typedef typename converter_1::decoded_type decoded_type;
-	typedef typename converter_3::encoded_type encoded_type;
-
-	combined_converter(decoded_type& value, typename C1::params p1, typename C2::params p2, typename C3::params p3)
-	: conv2_decoded()
-	, conv3_decoded()
-	, c1(value        , p1)
-	, c2(conv2_decoded, p2)
-	, c3(conv3_decoded, p3)
-	{}
+template<typename ConverterType>
+struct converter_stages<ConverterType, void> {
+	typedef typename ConverterType::decoded_type decoded_type;
+	typedef typename ConverterType::encoded_type encoded_type;
 
-	encoded_type encode() const {
-		conv2_decoded = c1.encode();
-		conv3_decoded = c2.encode();
-		return          c3.encode();
-	}
+	explicit converter_stages(const typename ConverterType::params& p) : p(p) {}
 
-	void decode(encoded_type arg) const {
-		c3.decode(arg          );
-		c2.decode(conv3_decoded);
-		c1.decode(conv2_decoded);
-	}
+	encoded_type encode(decoded_type value) const { return ConverterType::encode(value, p); }
+	decoded_type decode(encoded_type arg  ) const { return ConverterType::decode(arg  , p); }
 
-private:
+	typename ConverterType::params p;
+};
 
-	typedef typename converter_2::decoded_type conv2_decoded_type;
-	typedef typename converter_3::decoded_type conv3_decoded_type;
+#if __cplusplus >= 201103L
+template<typename ConverterType, typename... ConverterTypes>
+struct make_converter_stages {
+	typedef converter_stages<ConverterType, typename make_converter_stages<ConverterTypes...>::type> type;
+};
 
-	mutable conv2_decoded_type conv2_decoded;
-	mutable conv3_decoded_type conv3_decoded;
+template<typename ConverterType>
+struct make_converter_stages<ConverterType> {
+	typedef converter_stages<ConverterType, void> type;
+};
+#else
+template<typename C1, typename C2, typename C3, typename C4, typename C5>
+struct make_converter_stages {
+	typedef converter_stages<C1, typename make_converter_stages<C2, C3, C4, C5, void>::type> type;
+};
+
+template<typename C1>
+struct make_converter_stages<C1, void, void, void, void> {
+	typedef converter_stages<C1, void> type;
+};
+
+template<typename ConverterType>
+struct converter_params {
+	typedef typename ConverterType::params type;
+};
 
-	converter_1 c1;
-	converter_2 c2;
-	converter_3 c3;
+template<>
+struct converter_params<void> {
+	struct type {};
 };
+#endif
+
+} // detail
+
+/*
+ * converts with C1, then with C2 the result of C1 and so on, and the other way round for decoding.
+ * the stages are converters with static encode(decoded_type, params) and decode(encoded_type, params)
+ * like the ones in converter.hpp; only their params are stored, so the conversion is a sequence of
+ * inlined function calls without temporaries in the converter. with C++11 any number of stages can
+ * be combined, otherwise up to 5.
+ *
+ * params are constructed from the params of the stages, so combined converters are stages themselves
+ */
+#if __cplusplus >= 201103L
+
+template<typename... ConverterTypes>
+class combined_converter : public converter<combined_converter<ConverterTypes...> > {
+	typedef typename detail::make_converter_stages<ConverterTypes...>::type stages_type;
 
-template<typename C1, typename C2, typename C3, typename C4>
-class combined_converter<C1, C2, C3, C4, void> : public converter<typename C1::decoded_type, typename C4::encoded_type>{
 public:
-	typedef C1                                 converter_1;
-	typedef C2                                 converter_2;
-	typedef C3                                 converter_3;
-	typedef C4                                 converter_4;
-	typedef typename converter_1::decoded_type decoded_type;
-	typedef typename converter_4::encoded_type encoded_type;
+	typedef typename stages_type::decoded_type decoded_type;
+	typedef typename stages_type::encoded_type encoded_type;
+	typedef stages_type                        params;
 
-	combined_converter( decoded_type& value
-	                  , typename C1::params p1
-	                  , typename C2::params p2
-	                  , typename C3::params p3
-	                  , typename C4::params p4)
-	: conv2_decoded()
-	, conv3_decoded()
-	, conv4_decoded()
-	, c1(value        , p1)
-	, c2(conv2_decoded, p2)
-	, c3(conv3_decoded, p3)
-	, c4(conv4_decoded, p4)
+	combined_converter(decoded_type& value, typename ConverterTypes::params... p)
+	: value (value)
+	, stages(p...)
 	{}
 
-	encoded_type encode() const {
-		conv2_decoded = c1.encode();
-		conv3_decoded = c2.encode();
-		conv4_decoded = c3.encode();
-		return          c4.encode();
-	}
+	encoded_type encode()                 const { return  stages.encode(value); }
+	void         decode(encoded_type arg) const { value = stages.decode(arg  ); }
 
-	void decode(encoded_type arg) const {
-		c4.decode(arg          );
-		c3.decode(conv4_decoded);
-		c2.decode(conv3_decoded);
-		c1.decode(conv2_decoded);
-	}
+	static encoded_type encode(decoded_type value, const params& p) { return p.encode(value); }
+	static decoded_type decode(encoded_type arg  , const params& p) { return p.decode(arg  ); }
 
 private:
+	decoded_type& value;
+	stages_type   stages;
+};
 
-	typedef typename converter_2::decoded_type conv2_decoded_type;
-	typedef typename converter_3::decoded_type conv3_decoded_type;
-	typedef typename converter_4::decoded_type conv4_decoded_type;
-
-	mutable conv2_decoded_type conv2_decoded;
-	mutable conv3_decoded_type conv3_decoded;
-	mutable conv4_decoded_type conv4_decoded;
+#else
 
-	converter_1 c1;
-	converter_2 c2;
-	converter_3 c3;
-	converter_4 c4;
-};
+template<typename C1, typename C2, typename C3 = void, typename C4 = void, typename C5 = void>
+class combined_converter : public converter<combined_converter<C1, C2, C3, C4, C5> > {
+	typedef typename detail::make_converter_stages<C1, C2, C3, C4, C5>::type stages_type;
 
-template<typename C1, typename C2, typename C3, typename C4, typename C5>
-class combined_converter : public converter<typename C1::decoded_type, typename C5::encoded_type>{
 public:
-	typedef C1                                 converter_1;
-	typedef C2                                 converter_2;
-	typedef C3                                 converter_3;
-	typedef C4                                 converter_4;
-	typedef C5                                 converter_5;
-	typedef typename converter_1::decoded_type decoded_type;
-	typedef typename converter_5::encoded_type encoded_type;
+	typedef typename stages_type::decoded_type decoded_type;
+	typedef typename stages_type::encoded_type encoded_type;
+	typedef stages_type                        params;
+
+	combined_converter( decoded_type& value
+	                  , typename C1::params p1
+	                  , typename C2::params p2)
+	: value (value)
+	, stages(p1, p2)
+	{}
 
 	combined_converter( decoded_type& value
 	                  , typename C1::params p1
 	                  , typename C2::params p2
-	                  , typename C3::params p3
-	                  , typename C4::params p4
-	                  , typename C5::params p5)
-	: conv2_decoded()
-	, conv3_decoded()
-	, conv4_decoded()
-	, conv5_decoded()
-	, c1(value        , p1)
-	, c2(conv2_decoded, p2)
-	, c3(conv3_decoded, p3)
-	, c4(conv4_decoded, p4)
-	, c5(conv5_decoded, p5)
+	                  , typename detail::converter_params<C3>::type p3)
+	: value (value)
+	, stages(p1, p2, p3)
 	{}
 
-	encoded_type encode() const {
-		conv2_decoded = c1.encode();
-		conv3_decoded = c2.encode();
-		conv4_decoded = c3.encode();
-		conv5_decoded = c4.encode();
-		return          c5.encode();
-	}
-
-	void decode(encoded_type arg) const {
-		c5.decode(arg          );
-		c4.decode(conv5_decoded);
-		c3.decode(conv4_decoded);
-		c2.decode(conv3_decoded);
-		c1.decode(conv2_decoded);
-	}
+	combined_converter( decoded_type& value
+	                  , typename C1::params p1
+	                  , typename C2::params p2
+	                  , typename detail::converter_params<C3>::type p3
+	                  , typename detail::converter_params<C4>::type p4)
+	: value (value)
+	, stages(p1, p2, p3, p4)
+	{}
 
-private:
+	combined_converter( decoded_type& value
+	                  , typename C1::params p1
+	                  , typename C2::params p2
+	                  , typename detail::converter_params<C3>::type p3
+	                  , typename detail::converter_params<C4>::type p4
+	                  , typename detail::converter_params<C5>::type p5)
+	: value (value)
+	, stages(p1, p2, p3, p4, p5)
+	{}
+
+	encoded_type encode()                 const { return  stages.encode(value); }
+	void         decode(encoded_type arg) const { value = stages.decode(arg  ); }
+
+	static encoded_type encode(decoded_type value, const params& p) { return p.encode(value); }
+	static decoded_type decode(encoded_type arg  , const params& p) { return p.decode(arg  ); }
 
-	typedef typename converter_2::decoded_type conv2_decoded_type;
-	typedef typename converter_3::decoded_type conv3_decoded_type;
-	typedef typename converter_4::decoded_type conv4_decoded_type;
-	typedef typename converter_5::decoded_type conv5_decoded_type;
-
-	mutable conv2_decoded_type conv2_decoded;
-	mutable conv3_decoded_type conv3_decoded;
-	mutable conv4_decoded_type conv4_decoded;
-	mutable conv5_decoded_type conv5_decoded;
-
-	converter_1 c1;
-	converter_2 c2;
-	converter_3 c3;
-	converter_4 c4;
-	converter_5 c5;
+private:
+	decoded_type& value;
+	stages_type   stages;
 };
 
+#endif
+
 }
 
 #endif /* SHIFT_TYPES_COMBINED_CONVERTER_HPP_ */
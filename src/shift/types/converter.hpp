@@ -7,20 +7,68 @@
 #ifndef SHIFT_TYPES_CONVERTER_HPP_
 #define SHIFT_TYPES_CONVERTER_HPP_
 
+#include <limits>
+
 #include <shift/types/fixed_width_uint.hpp>
 
 namespace shift {
 
-template<typename DecodedType, typename EncodedType>
+namespace detail {
+
+/*
+ * conversion of floating point values to integral types: values beyond the range of the integral
+ * type saturate to its minimum or maximum instead of being undefined, NaN is converted to 0. other
+ * conversions are plain casts
+ */
+template<typename ToType, typename FromType, bool Saturating = !std::numeric_limits<FromType>::is_integer && std::numeric_limits<ToType>::is_integer>
+struct saturating_conversion {
+	static ToType convert(FromType value) { return static_cast<ToType>(value); }
+};
+
+template<typename ToType, typename FromType>
+struct saturating_conversion<ToType, FromType, true> {
+	static ToType convert(FromType value) {
+		if (value != value)
+			return ToType(0);
+		if (value <= static_cast<FromType>(std::numeric_limits<ToType>::min()))
+			return std::numeric_limits<ToType>::min();
+		if (value >= static_cast<FromType>(std::numeric_limits<ToType>::max()))
+			return std::numeric_limits<ToType>::max();
+		return static_cast<ToType>(value);
+	}
+};
+
+template<typename ToType, typename FromType>
+inline ToType saturate_cast(FromType value) {
+	return saturating_conversion<ToType, FromType>::convert(value);
+}
+
+} // detail
+
+/*
+ * base of converters, which define decoded_type, encoded_type, encode() and decode(encoded_type)
+ * as the ones below. the stream operators call them through the derived type instead of virtual
+ * functions, so conversions are inlined into the surrounding code.
+ *
+ * the converters below also convert values with given params in static encode(decoded_type, params)
+ * and decode(encoded_type, params), of which combined_converter composes its stages
+ */
+template<typename ConverterType>
 class converter {
 public:
-	virtual ~converter(){}
-	virtual EncodedType encode()                const = 0;
-	virtual void        decode(EncodedType arg) const = 0;
+	const ConverterType& derived() const { return static_cast<const ConverterType&>(*this); }
+
+protected:
+	converter() {}
+	~converter() {}
 };
 
+/*
+ * scaled floating point values beyond the range of an integral encoded type saturate, see
+ * detail::saturate_cast
+ */
 template<typename DecodedType, typename EncodedType, typename ScaleType = DecodedType>
-class scale_converter : public converter<DecodedType, EncodedType> {
+class scale_converter : public converter<scale_converter<DecodedType, EncodedType, ScaleType> > {
 public:
 	typedef ScaleType   scale_type;
 	typedef DecodedType decoded_type;
@@ -32,27 +80,28 @@ public:
 	};
 
 	scale_converter(decoded_type& value, scale_type factor)
-	: converter<DecodedType, EncodedType>()
-	, value(value)
+	: value(value)
 	, factor(factor)
 	{}
 
 	scale_converter(decoded_type& value, params p)
-	: converter<DecodedType, EncodedType>()
-	, value(value)
+	: value(value)
 	, factor(p.factor)
 	{}
 
-	encoded_type encode()                 const { return  static_cast<encoded_type>(value * factor); }
+	encoded_type encode()                 const { return  detail::saturate_cast<encoded_type>(value * factor); }
 	void         decode(encoded_type arg) const { value = static_cast<decoded_type>(arg   / factor) ; }
 
+	static encoded_type encode(decoded_type value, const params& p) { return detail::saturate_cast<encoded_type>(value * p.factor); }
+	static decoded_type decode(encoded_type arg  , const params& p) { return static_cast<decoded_type>(arg   / p.factor); }
+
 private:
-	mutable decoded_type& value;
+	decoded_type&         value;
 	scale_type            factor;
 };
 
 template<typename DecodedType, typename EncodedType, typename OffsetType = DecodedType>
-class offset_converter : public converter<DecodedType, EncodedType> {
+class offset_converter : public converter<offset_converter<DecodedType, EncodedType, OffsetType> > {
 public:
 	typedef OffsetType  offset_type;
 	typedef DecodedType decoded_type;
@@ -69,13 +118,47 @@ public:
 	encoded_type encode()                 const { return  static_cast<encoded_type>(value + offset); }
 	void         decode(encoded_type arg) const { value = static_cast<decoded_type>(arg   - offset); }
 
+	static encoded_type encode(decoded_type value, const params& p) { return static_cast<encoded_type>(value + p.offset); }
+	static decoded_type decode(encoded_type arg  , const params& p) { return static_cast<decoded_type>(arg   - p.offset); }
+
 private:
-	mutable decoded_type& value;
+	decoded_type&         value;
 	offset_type           offset;
 };
 
+/*
+ * limits values to [lower, upper] before the cast, so values beyond the range of the encoded type are
+ * saturated instead of wrapped. NaN passes the limits and is encoded as 0, see detail::saturate_cast
+ */
+template<typename DecodedType, typename EncodedType>
+class clamp_converter : public converter<clamp_converter<DecodedType, EncodedType> > {
+public:
+	typedef DecodedType decoded_type;
+	typedef EncodedType encoded_type;
+
+	struct params {
+		params(decoded_type lower, decoded_type upper) : lower(lower), upper(upper) {}
+		decoded_type lower;
+		decoded_type upper;
+	};
+
+	clamp_converter(decoded_type& value, decoded_type lower, decoded_type upper) : value(value), lower(  lower), upper(  upper) {}
+	clamp_converter(decoded_type& value, params       p                        ) : value(value), lower(p.lower), upper(p.upper) {}
+
+	encoded_type encode()                 const { return  encode(value, params(lower, upper)); }
+	void         decode(encoded_type arg) const { value = decode(arg  , params(lower, upper)); }
+
+	static encoded_type encode(decoded_type value, const params& p) { return detail::saturate_cast<encoded_type>(value < p.lower ? p.lower : p.upper < value ? p.upper : value); }
+	static decoded_type decode(encoded_type arg  , const params&  ) { return static_cast<decoded_type>(arg); }
+
+private:
+	decoded_type&         value;
+	decoded_type          lower;
+	decoded_type          upper;
+};
+
 template<typename DecodedType, typename EncodedType>
-class type_converter : public converter<DecodedType, EncodedType> {
+class type_converter : public converter<type_converter<DecodedType, EncodedType> > {
 public:
 	typedef DecodedType decoded_type;
 	typedef EncodedType encoded_type;
@@ -88,12 +171,15 @@ public:
 	encoded_type encode()                 const { return  static_cast<encoded_type>(value); }
 	void         decode(encoded_type arg) const { value = static_cast<decoded_type>(arg  ); }
 
+	static encoded_type encode(decoded_type value, const params&) { return static_cast<encoded_type>(value); }
+	static decoded_type decode(encoded_type arg  , const params&) { return static_cast<decoded_type>(arg  ); }
+
 private:
-	mutable decoded_type& value;
+	decoded_type&         value;
 };
 
 template<typename DecodedType, typename UintType, unsigned int NBits>
-class type_converter<DecodedType, shift::fixed_width_uint<UintType, NBits> > : public converter<DecodedType, shift::fixed_width_uint<UintType, NBits> > {
+class type_converter<DecodedType, shift::fixed_width_uint<UintType, NBits> > : public converter<type_converter<DecodedType, shift::fixed_width_uint<UintType, NBits> > > {
 public:
 	typedef DecodedType                              decoded_type;
 	typedef shift::fixed_width_uint<UintType, NBits> encoded_type;
@@ -106,8 +192,11 @@ public:
 	encoded_type encode()                 const { return  static_cast<encoded_type>( value); }
 	void         decode(encoded_type arg) const { value = static_cast<decoded_type>(*arg  ); }
 
+	static encoded_type encode(decoded_type value, const params&) { return static_cast<encoded_type>( value); }
+	static decoded_type decode(encoded_type arg  , const params&) { return static_cast<decoded_type>(*arg  ); }
+
 private:
-	mutable decoded_type& value;
+	decoded_type&         value;
 };
 
 }
@@ -0,0 +1,80 @@
+
+//          Copyright Michael Mehling 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef SHIFT_TYPES_STRING_VIEW_HPP_
+#define SHIFT_TYPES_STRING_VIEW_HPP_
+
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+namespace shift {
+
+/*
+ * non-owning range of characters. decoded from a source, it points into the buffer of the source:
+ * it is valid for the lifetime of the buffer of sources over memory, but only until the next
+ * extraction from sources with a reader
+ */
+class string_view {
+public:
+	typedef const char* const_iterator;
+
+	string_view(                                  ) : data_(0         ), size_(0               ) {}
+	string_view(const char* data, std::size_t size) : data_(data      ), size_(size            ) {}
+	string_view(const char* str                   ) : data_(str       ), size_(std::strlen(str)) {}
+	string_view(const std::string& str            ) : data_(str.data()), size_(str.size()      ) {}
+
+	string_view& assign(const char* first, const char* last) { data_ = first; size_ = last - first; return *this; }
+
+	const char*    data  () const                  { return data_; }
+	std::size_t    size  () const                  { return size_; }
+	std::size_t    length() const                  { return size_; }
+	bool           empty () const                  { return size_ == 0; }
+
+	const_iterator begin () const                  { return data_; }
+	const_iterator end   () const                  { return data_ + size_; }
+
+	char           operator[](std::size_t i) const { return data_[i]; }
+
+	std::string    str   () const                  { return std::string(data_, size_); }
+
+	int compare(const string_view& other) const {
+		const int result = size_ == 0 || other.size_ == 0 ? 0 : std::memcmp(data_, other.data_, std::min(size_, other.size_));
+		return result != 0 ? result : size_ < other.size_ ? -1 : size_ > other.size_ ? 1 : 0;
+	}
+
+private:
+	const char* data_;
+	std::size_t size_;
+};
+
+inline bool operator == ( const string_view& x, const string_view& y ) { return x.size() == y.size() && x.compare(y) == 0; }
+inline bool operator != ( const string_view& x, const string_view& y ) { return !(x == y); }
+
+inline bool operator <  ( const string_view& x, const string_view& y ) { return x.compare(y) <  0; }
+inline bool operator >  ( const string_view& x, const string_view& y ) { return x.compare(y) >  0; }
+
+inline bool operator <= ( const string_view& x, const string_view& y ) { return x.compare(y) <= 0; }
+inline bool operator >= ( const string_view& x, const string_view& y ) { return x.compare(y) >= 0; }
+
+//
+
+inline bool operator == ( const string_view& x, const std::string& y ) { return x == string_view(y); }
+inline bool operator != ( const string_view& x, const std::string& y ) { return x != string_view(y); }
+
+inline bool operator == ( const std::string& x, const string_view& y ) { return string_view(x) == y; }
+inline bool operator != ( const std::string& x, const string_view& y ) { return string_view(x) != y; }
+
+inline bool operator == ( const string_view& x, const char* y        ) { return x == string_view(y); }
+inline bool operator != ( const string_view& x, const char* y        ) { return x != string_view(y); }
+
+inline bool operator == ( const char* x, const string_view& y        ) { return string_view(x) == y; }
+inline bool operator != ( const char* x, const string_view& y        ) { return string_view(x) != y; }
+
+} // shift
+
+#endif /* SHIFT_TYPES_STRING_VIEW_HPP_ */
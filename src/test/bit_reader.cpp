@@ -0,0 +1,101 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include <shift/buffer/static_buffer.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/bit_writer.hpp>
+#include <shift/bit_reader.hpp>
+
+#include <test/utility.hpp>
+
+namespace test { namespace {
+
+typedef shift::fixed_width_uint<shift::uint64_t, 37> uint37_t;
+typedef shift::fixed_width_uint<shift::uint64_t, 64> uint64_bits_t;
+
+TEST_CASE( "bit_reader: consecutive fields are extracted without padding"
+         , "[bit_reader]")
+{
+	typedef shift::static_buffer<256> buffer_t;
+	typedef shift::sink<shift::little_endian, buffer_t> sink_t;
+	typedef shift::source<shift::little_endian> source_t;
+
+	const unsigned int n = 17;
+	sink_t sink;
+	{
+		shift::bit_writer<sink_t> writer(sink);
+		for (unsigned int i=0; i<n; ++i)
+			writer << shift::uint3_t(i % 8) << shift::uint12_t(i * 331) << (i % 3 == 0)
+			       << uint37_t(i * 2654435761ULL) << uint64_bits_t(~static_cast<shift::uint64_t>(i));
+		writer.flush();
+	}
+
+	source_t source(sink.buffer(), sink.size());
+	shift::bit_reader<source_t> reader(source);
+	for (unsigned int i=0; i<n; ++i) {
+		shift::uint3_t  v1;
+		shift::uint12_t v2;
+		bool            v3 = false;
+		uint37_t        v4;
+		uint64_bits_t   v5;
+		reader >> v1 >> v2 >> v3 >> v4 >> v5;
+
+		CAPTURE(i);
+		CHECK(*v1 == i % 8);
+		CHECK(*v2 == ((i * 331) & 0xFFF));
+		CHECK(v3  == (i % 3 == 0));
+		CHECK(*v4 == ((i * 2654435761ULL) & 0x1FFFFFFFFFULL));
+		CHECK(*v5 == ~static_cast<shift::uint64_t>(i));
+	}
+}
+
+TEST_CASE( "bit_reader: reading starts at the current position of the source, align() continues at the next byte"
+         , "[bit_reader]")
+{
+	typedef shift::source<shift::big_endian> source_t;
+	const shift::byte_type buffer[] = { 0x00, 0x00, 0xF8, 0x7F, 0x2A };
+	source_t source(buffer, sizeof(buffer));
+
+	source >> shift::buffer_position(2, 2);
+	shift::bit_reader<source_t> reader(source);
+	shift::uint4_t v1;
+	shift::uint7_t v2;
+	reader >> v1 >> v2;
+	reader.align();
+
+	shift::uint8_t v3 = 0;
+	source >> v3;
+
+	CHECK(*v1 == 0);
+	CHECK(*v2 == 127);
+	CHECK(v3  == 42);
+}
+
+TEST_CASE( "bit_reader: fields at the end of the buffer are extracted, reading beyond the end throws out_of_range"
+         , "[bit_reader]")
+{
+	typedef shift::source<shift::little_endian> source_t;
+	const shift::byte_type buffer[] = { 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xAB, 0xCD };
+	source_t source(buffer, sizeof(buffer));
+
+	source >> shift::buffer_position(4, 3);
+	shift::bit_reader<source_t> reader(source);
+	shift::fixed_width_uint<shift::uint64_t, 38> v1;
+	shift::uint3_t v2;
+	reader >> v1 >> v2;
+	CHECK(*v1 == 0x3C03FC02AFULL);
+	CHECK(*v2 == 1);
+
+	try {
+		shift::uint4_t v3;
+		reader >> v3;
+		CHECK(false);
+	} catch (const shift::out_of_range& e) {
+		CHECK(e.value() == sizeof(buffer));
+		CHECK((e.range() == shift::out_of_range::range_type(0, sizeof(buffer))));
+	}
+}
+
+}} // test
@@ -0,0 +1,114 @@
+#include <catch.hpp>
+
+#include <shift/buffer/static_buffer.hpp>
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/bit_writer.hpp>
+
+#include <test/utility.hpp>
+
+namespace test { namespace {
+
+shift::buffer_position bit_position(unsigned int n_bits) {
+	return shift::buffer_position(n_bits / 8, 7 - n_bits % 8);
+}
+
+template<typename SinkType>
+void write_fields_sequentially(SinkType& sink, unsigned int n) {
+	shift::bit_writer<SinkType> writer(sink);
+	for (unsigned int i=0; i<n; ++i) {
+		writer << shift::uint3_t (i % 8   )
+		       << shift::uint12_t(i * 331 )
+		       << (i % 3 == 0)
+		       << shift::fixed_width_uint<shift::uint64_t, 37>(i * 2654435761ULL);
+	}
+	writer.flush();
+}
+
+template<typename SinkType>
+void write_fields_at_positions(SinkType& sink, unsigned int n) {
+	unsigned int bit = 0;
+	for (unsigned int i=0; i<n; ++i) {
+		sink << bit_position(bit) << shift::uint3_t (i % 8   ); bit +=  3;
+		sink << bit_position(bit) << shift::uint12_t(i * 331 ); bit += 12;
+		sink << bit_position(bit) << (i % 3 == 0);              bit +=  1;
+		sink << bit_position(bit) << shift::fixed_width_uint<shift::uint64_t, 37>(i * 2654435761ULL); bit += 37;
+	}
+}
+
+TEST_CASE( "bit_writer: consecutive fields are packed without padding, the result equals writing each field at an \
+            explicit position"
+         , "[bit_writer]")
+{
+	typedef shift::static_buffer<128> buffer_t;
+	typedef shift::sink<shift::little_endian, buffer_t> sink_t;
+
+	for (unsigned int n=0; n<19; ++n) {
+		sink_t packed;
+		sink_t positioned;
+
+		write_fields_sequentially(packed, n);
+		write_fields_at_positions(positioned, n);
+
+		CAPTURE(n);
+		REQUIRE(packed.size() == positioned.size());
+		REQUIRE(packed.size() == (n * 53 + 7) / 8);
+		for (unsigned int i=0; i<buffer_t::size; ++i)
+			CHECK(packed.buffer()[i] == positioned.buffer()[i]);
+	}
+}
+
+TEST_CASE( "bit_writer: writing starts at the current bit position of the sink and preserves the preceding bits"
+         , "[bit_writer]")
+{
+	typedef shift::sink<shift::big_endian, shift::vector> sink_t;
+	sink_t sink;
+
+	sink << shift::buffer_position(2, 7) << shift::uint5_t(31);
+	sink << shift::buffer_position(2, 2);
+	{
+		shift::bit_writer<sink_t> writer(sink);
+		writer << shift::uint4_t(0) << shift::uint7_t(127);
+		writer.flush();
+	}
+
+	CHECK(sink.size() == 4);
+	CHECK(sink.buffer()[2] == 0xF8);
+	CHECK(sink.buffer()[3] == 0x7F);
+}
+
+TEST_CASE( "bit_writer: after flush() the sink continues at the beginning of the next byte"
+         , "[bit_writer]")
+{
+	typedef shift::static_buffer<16> buffer_t;
+	typedef shift::sink<shift::little_endian, buffer_t> sink_t;
+	sink_t sink;
+
+	shift::bit_writer<sink_t> writer(sink);
+	writer << shift::uint3_t(5) << shift::uint12_t(0xABC);
+	writer.flush();
+	writer.flush();
+	sink << static_cast<shift::uint8_t>(42);
+
+	CHECK(sink.size() == 3);
+	CHECK(sink.buffer()[0] == 0xB5);
+	CHECK(sink.buffer()[1] == 0x78);
+	CHECK(sink.buffer()[2] == 42);
+}
+
+TEST_CASE( "bit_writer: out_of_range is thrown when the packed bits exceed the capacity of the buffer"
+         , "[bit_writer]")
+{
+	typedef shift::static_buffer<8> buffer_t;
+	typedef shift::sink<shift::little_endian, buffer_t> sink_t;
+	sink_t sink;
+
+	shift::bit_writer<sink_t> writer(sink);
+	for (unsigned int i=0; i<7; ++i)
+		writer << shift::uint12_t(i);
+
+	CHECK(sink.size() == 8);
+	CHECK_THROWS_AS(writer.flush(), const shift::out_of_range&);
+}
+
+}} // test
@@ -27,7 +27,7 @@ typedef  shift::byte_type byte_type;
 	} catch(const shift::out_of_range& e) {                                  \
 		CHECK(true);                                                         \
 		CHECK(e.value() == index);                                           \
-		CHECK(e.range() == std::make_pair<unsigned int>(0, buffer_size  ));  \
+		CHECK(e.range() == shift::out_of_range::range_type(0, buffer_size  ));  \
 	}                                                                        \
 
 TEST_CASE( "buffer_interface: allocated memory is cleared on construction"
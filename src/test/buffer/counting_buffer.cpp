@@ -0,0 +1,80 @@
+#include <catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include <shift/buffer/counting_buffer.hpp>
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/reservation.hpp>
+#include <shift/operator/repeated.hpp>
+#include <shift/operator/string.hpp>
+#include <shift/operator/var_int.hpp>
+#include <shift/operator/universal.hpp>
+#include <shift/types/var_int.hpp>
+
+namespace test { namespace {
+
+template<typename SinkType>
+SinkType& write_message(SinkType& sink, unsigned int i) {
+	std::vector<shift::uint32_t> values;
+	for (unsigned int j=0; j<i * 40; ++j)
+		values.push_back(j * j * i);
+
+	sink % static_cast<shift::uint8_t >(i)
+	     % static_cast<double         >(i / 2.0)
+	     % shift::uint12_t(i)
+	     % (i % 2 == 0)
+	     % shift::var_int<shift::int64_t>(static_cast<shift::int64_t>(0 - (shift::uint64_t(i) << (i * 3))))
+	     % shift::ostring<shift::variable_length>(std::string(i * 50, 'x'))
+	     % shift::orepeated<shift::uint16_t, std::vector<shift::uint32_t>::const_iterator>(values.begin(), values.end())
+	     % shift::orepeated<shift::stream_vbyte, std::vector<shift::uint32_t>::const_iterator>(values.begin(), values.end());
+	return sink;
+}
+
+template<shift::endianness Endianness>
+void check_counted_size_equals_encoded_size() {
+	typedef shift::sink<Endianness, shift::counting_buffer> counting_sink_type;
+	typedef shift::sink<Endianness, shift::vector>          sink_type;
+
+	for (unsigned int i=0; i<20; ++i) {
+		CAPTURE(i);
+		counting_sink_type counting;
+		sink_type          sink;
+		write_message(counting, i);
+		write_message(sink    , i);
+		CHECK(counting.size() == sink.size());
+		CHECK(counting.buffer() == NULL);
+	}
+}
+
+TEST_CASE( "counting_buffer: a sink over it has the size of the encoded data"
+         , "[counting_buffer]")
+{
+	check_counted_size_equals_encoded_size<shift::little_endian>();
+	check_counted_size_equals_encoded_size<shift::big_endian   >();
+}
+
+TEST_CASE( "counting_buffer: positions and reservations are followed"
+         , "[counting_buffer]")
+{
+	typedef shift::sink<shift::big_endian, shift::counting_buffer> sink_type;
+
+	sink_type sink;
+	sink << shift::buffer_position(10, 3) << true;
+	CHECK(sink.size() == 11);
+
+	sink << shift::buffer_position(4) << shift::uint32_t(7);
+	CHECK(sink.size() == 11);
+
+	{
+		shift::reservation<sink_type> reservation(sink, 20);
+		reservation.sink() << shift::uint64_t(1) << shift::uint64_t(2);
+	}
+	CHECK(sink.size() == 24);
+
+	sink.clear();
+	CHECK(sink.size() == 0);
+}
+
+}} // test
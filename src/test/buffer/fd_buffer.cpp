@@ -0,0 +1,149 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <vector>
+
+#include <unistd.h>
+
+#include <shift/buffer/fd_buffer.hpp>
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/reservation.hpp>
+
+namespace test { namespace {
+
+typedef shift::fd_buffer buffer_type;
+
+std::vector<shift::byte_type> file_content(int fd) {
+	std::vector<shift::byte_type> content(::lseek(fd, 0, SEEK_END));
+	::lseek(fd, 0, SEEK_SET);
+	if (!content.empty())
+		REQUIRE(::read(fd, &content[0], content.size()) == static_cast<ssize_t>(content.size()));
+	return content;
+}
+
+template<typename SinkType>
+void write_records(SinkType& sink, unsigned int n) {
+	for (unsigned int i=0; i<n; ++i)
+		sink << static_cast<shift::uint32_t>(i) << static_cast<shift::uint8_t>(i) << shift::uint4_t(i) << (i % 3 == 0);
+}
+
+TEST_CASE( "fd_buffer: the content written to the file descriptor equals the content of an in-memory sink"
+         , "[fd_buffer]")
+{
+	std::FILE* file = std::tmpfile();
+	REQUIRE(file != NULL);
+	const int fd = fileno(file);
+
+	typedef shift::sink<shift::big_endian, buffer_type>   fd_sink_t;
+	typedef shift::sink<shift::big_endian, shift::vector> vector_sink_t;
+
+	const unsigned int n = 50000;
+	{
+		fd_sink_t sink(buffer_type::initialization_params(fd, 64, 4));
+		write_records(sink, n);
+		shift::flush(sink);
+	}
+
+	vector_sink_t expected;
+	write_records(expected, n);
+
+	const std::vector<shift::byte_type> content = file_content(fd);
+	REQUIRE(content.size() == expected.size());
+	for (std::size_t i=0; i<content.size(); ++i)
+		REQUIRE(content[i] == expected.buffer()[i]);
+
+	std::fclose(file);
+}
+
+TEST_CASE( "fd_buffer: positions inside the unflushed chunks can be overwritten, flushed positions throw out_of_range"
+         , "[fd_buffer]")
+{
+	std::FILE* file = std::tmpfile();
+	REQUIRE(file != NULL);
+	const int fd = fileno(file);
+
+	typedef shift::sink<shift::little_endian, buffer_type> sink_t;
+	sink_t sink(buffer_type::initialization_params(fd, 16, 4));
+
+	for (unsigned int i=0; i<100; ++i)
+		sink << static_cast<shift::uint8_t>(i);
+
+	// the four completed chunks were written out when byte 64 crossed into a new chunk
+
+	const std::size_t flushed = shift::detail::ostream_operator_interface<sink_t>::get_buffer(sink).flushed();
+	CHECK(flushed == 64);
+
+	sink << shift::buffer_position(flushed) << static_cast<shift::uint16_t>(0xBBAA);
+	sink << shift::buffer_position(95)      << static_cast<shift::uint16_t>(0xDDCC);
+
+	try {
+		sink << shift::buffer_position(flushed - 1) << static_cast<shift::uint8_t>(0);
+		CHECK(false);
+	} catch (const shift::out_of_range& e) {
+		CHECK(e.value() == flushed - 1);
+	}
+
+	sink << shift::buffer_position(100);
+	CHECK_THROWS_AS(shift::reservation<sink_t>(sink, 17), const shift::out_of_range&);
+	{
+		shift::reservation<sink_t> r(sink, 16);
+		for (unsigned int i=0; i<16; ++i)
+			r.sink() << static_cast<shift::uint8_t>(i);
+	}
+	sink << shift::buffer_position(200) << shift::buffer_position(500) << static_cast<shift::uint8_t>(1);
+	shift::flush(sink);
+
+	const std::vector<shift::byte_type> content = file_content(fd);
+	REQUIRE(content.size() == 501);
+	for (unsigned int i=0; i<95; ++i) {
+		if      (i == flushed    ) CHECK(content[i] == 0xAA);
+		else if (i == flushed + 1) CHECK(content[i] == 0xBB);
+		else                       CHECK(content[i] == i);
+	}
+	CHECK(content[95] == 0xCC);
+	CHECK(content[96] == 0xDD);
+	for (unsigned int i=97; i<100; ++i)
+		CHECK(content[i] == i);
+	for (unsigned int i=0; i<16; ++i)
+		CHECK(content[100 + i] == i);
+	for (unsigned int i=116; i<500; ++i)
+		CHECK(content[i] == 0);
+	CHECK(content[500] == 1);
+
+	std::fclose(file);
+}
+
+TEST_CASE( "fd_buffer: blocks larger than all chunks are streamed in pieces"
+         , "[fd_buffer]")
+{
+	std::FILE* file = std::tmpfile();
+	REQUIRE(file != NULL);
+	const int fd = fileno(file);
+
+	std::vector<double> values;
+	for (unsigned int i=0; i<1000; ++i)
+		values.push_back(i * 0.25);
+
+	{
+		typedef shift::sink<shift::big_endian, buffer_type> sink_t;
+		sink_t sink(buffer_type::initialization_params(fd, 32, 2));
+		sink << static_cast<shift::uint8_t>(7);
+		shift::detail::ostream_operator_interface<sink_t>::write_block(sink, reinterpret_cast<const shift::byte_type*>(&values[0]), values.size() * sizeof(double));
+		shift::flush(sink);
+	}
+
+	const std::vector<shift::byte_type> content = file_content(fd);
+	REQUIRE(content.size() == 1 + values.size() * sizeof(double));
+	CHECK(content[0] == 7);
+
+	const shift::byte_type* p = reinterpret_cast<const shift::byte_type*>(&values[0]);
+	const std::size_t       n = values.size() * sizeof(double);
+	const bool reversed = shift::sink<shift::big_endian, buffer_type>::requires_endianness_conversion();
+	for (std::size_t i=0; i<n; ++i)
+		REQUIRE(content[1 + i] == (reversed ? p[n - 1 - i] : p[i]));
+
+	std::fclose(file);
+}
+
+}} // test
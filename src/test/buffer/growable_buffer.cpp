@@ -0,0 +1,165 @@
+#include <catch.hpp>
+
+#include <vector>
+#include <iterator>
+
+#include <shift/buffer/growable_buffer.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/operator/repeated.hpp>
+#include <shift/operator/universal.hpp>
+
+namespace test { namespace {
+
+typedef shift::growable_buffer buffer_type;
+
+#define DEFINE_ARRAY(...)                                                    \
+	const shift::byte_type values[] = { __VA_ARGS__ };                       \
+	const unsigned n = sizeof(values) / sizeof(shift::byte_type);            \
+	CAPTURE(n);                                                              \
+
+TEST_CASE( "growable_buffer: single bytes and arrays of bytes can be written into the buffer"
+         , "[growable_buffer]")
+{
+	buffer_type buffer(buffer_type::initialization_params(4));
+	DEFINE_ARRAY(11, 25, 129, 42, 8);
+
+	buffer.write(7, 0);
+	buffer.write(values, 1, n);
+	buffer.reverse_write(values, 1 + n, n);
+
+	REQUIRE(buffer.size() == 1 + 2 * n);
+	CHECK(buffer.at(0) == 7);
+	for (unsigned i=0; i<n; ++i) {
+		CHECK(buffer.at(1 + i)     == values[i]);
+		CHECK(buffer.at(1 + n + i) == values[n-i-1]);
+	}
+}
+
+TEST_CASE( "growable_buffer: the capacity grows geometrically"
+         , "[growable_buffer]")
+{
+	buffer_type buffer(buffer_type::initialization_params(16));
+	CHECK(buffer.capacity() == 16);
+
+	unsigned int n_reallocations = 0;
+	for (unsigned i=0; i<100000; ++i) {
+		const std::size_t capacity = buffer.capacity();
+		buffer.write(static_cast<shift::byte_type>(i), i);
+		if (buffer.capacity() != capacity) {
+			CHECK(buffer.capacity() == 2 * capacity);
+			++n_reallocations;
+		}
+	}
+	CHECK(n_reallocations == 13);
+
+	for (unsigned i=0; i<100000; ++i)
+		REQUIRE(buffer.at(i) == static_cast<shift::byte_type>(i));
+}
+
+TEST_CASE( "growable_buffer: bytes skipped by writing beyond the end are zero"
+         , "[growable_buffer]")
+{
+	buffer_type buffer(buffer_type::initialization_params(8));
+	for (unsigned i=0; i<8; ++i)
+		buffer.write(0xFF, i);
+	buffer.reset();
+
+	buffer.write(1, 5);
+	buffer.write(2, 1000);
+
+	REQUIRE(buffer.size() == 1001);
+	for (unsigned i=0; i<1000; ++i)
+		REQUIRE(buffer.at(i) == (i == 5 ? 1 : 0));
+	CHECK(buffer.at(1000) == 2);
+}
+
+TEST_CASE( "growable_buffer: reset() discards the content but keeps the capacity"
+         , "[growable_buffer]")
+{
+	buffer_type buffer(buffer_type::initialization_params(8));
+	for (unsigned i=0; i<1000; ++i)
+		buffer.write(1, i);
+
+	const std::size_t capacity = buffer.capacity();
+	const shift::byte_type* p  = buffer.buffer();
+
+	buffer.reset();
+	CHECK(buffer.size()     == 0);
+	CHECK(buffer.capacity() == capacity);
+
+	for (unsigned i=0; i<1000; ++i)
+		buffer.write(2, i);
+	CHECK(buffer.buffer() == p);
+	CHECK(buffer.at(999)  == 2);
+}
+
+TEST_CASE( "growable_buffer: reading beyond the written range throws out_of_range"
+         , "[growable_buffer]")
+{
+	buffer_type buffer(buffer_type::initialization_params(64));
+	buffer.write(1, 9);
+
+	try {
+		buffer.at(10);
+		REQUIRE(false);
+	} catch(const shift::out_of_range& e) {
+		CHECK(e.value() == 10);
+		CHECK((e.range() == shift::out_of_range::range_type(0, 10)));
+	}
+}
+
+TEST_CASE( "growable_buffer: copies are independent"
+         , "[growable_buffer]")
+{
+	buffer_type a(buffer_type::initialization_params(2));
+	for (unsigned i=0; i<10; ++i)
+		a.write(i, i);
+
+	buffer_type b(a);
+	buffer_type c(buffer_type::initialization_params(0));
+	c = a;
+	a.write(0xFF, 0);
+
+	REQUIRE(b.size() == 10);
+	REQUIRE(c.size() == 10);
+	for (unsigned i=0; i<10; ++i) {
+		CHECK(b.at(i) == i);
+		CHECK(c.at(i) == i);
+	}
+}
+
+TEST_CASE( "growable_buffer: a sink that is cleared between messages encodes the same content"
+         , "[growable_buffer]")
+{
+	typedef shift::sink  <shift::big_endian, buffer_type> sink_t;
+	typedef shift::source<shift::big_endian>              source_t;
+	typedef std::vector<shift::uint32_t>                  container_type;
+
+	container_type values;
+	for (unsigned i=0; i<100000; ++i)
+		values.push_back(i * 7919);
+
+	sink_t sink;
+	for (unsigned int round=0; round<2; ++round) {
+		sink.clear();
+		sink << true << false << shift::orepeated<shift::uint32_t, container_type::const_iterator>(values.begin(), values.end()) << shift::uint4_t(5) << true;
+
+		container_type decoded;
+		bool b1 = false, b2 = true, b3 = false;
+		shift::uint4_t u;
+		source_t source(sink.buffer(), sink.size());
+		source >> b1 >> b2 >> shift::irepeated<shift::uint32_t, std::back_insert_iterator<container_type> >(std::back_inserter(decoded)) >> u >> b3;
+
+		CHECK(b1);
+		CHECK_FALSE(b2);
+		CHECK(*u == 5);
+		CHECK(b3);
+		REQUIRE(decoded.size() == values.size());
+		CHECK(decoded == values);
+	}
+}
+
+#undef DEFINE_ARRAY
+
+}} // test
@@ -0,0 +1,147 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <shift/buffer/mmap_buffer.hpp>
+#include <shift/buffer/vector.hpp>
+#include <shift/mapped_file.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/operator/universal.hpp>
+#include <shift/operator/string.hpp>
+
+namespace test { namespace {
+
+typedef shift::mmap_buffer buffer_type;
+
+std::size_t file_size(int fd) {
+	struct stat status;
+	REQUIRE(::fstat(fd, &status) == 0);
+	return status.st_size;
+}
+
+template<typename SinkType>
+void encode_records(SinkType& sink, unsigned int begin, unsigned int end) {
+	for (unsigned int i=begin; i<end; ++i)
+		sink << static_cast<shift::uint32_t>(i) << std::string(i % 5, 'm') << shift::uint4_t(i % 16) << static_cast<double>(i);
+}
+
+template<typename SourceType>
+void check_records(SourceType& source, unsigned int begin, unsigned int end) {
+	for (unsigned int i=begin; i<end; ++i) {
+		shift::uint32_t u   = 0;
+		std::string     str;
+		shift::uint4_t  u4;
+		double          d   = 0;
+		source >> u >> str >> u4 >> d;
+		REQUIRE(u   == i);
+		REQUIRE(str == std::string(i % 5, 'm'));
+		REQUIRE(*u4 == i % 16);
+		REQUIRE(d   == i);
+	}
+}
+
+TEST_CASE( "mmap_buffer: the mapped file holds the content of the sink, the mapping grows on demand"
+         , "[mmap_buffer]")
+{
+	std::FILE* file = std::tmpfile();
+	REQUIRE(file != NULL);
+	const int fd = fileno(file);
+
+	typedef shift::sink<shift::little_endian, buffer_type>   mmap_sink_t;
+	typedef shift::sink<shift::little_endian, shift::vector> vector_sink_t;
+
+	const unsigned int n = 20000;
+	{
+		mmap_sink_t sink(buffer_type::initialization_params(fd, 4096));
+		encode_records(sink, 0, n);
+		CHECK(shift::detail::ostream_operator_interface<mmap_sink_t>::get_buffer(sink).capacity() >= sink.size());
+
+		const std::size_t capacity = shift::detail::ostream_operator_interface<mmap_sink_t>::get_buffer(sink).capacity();
+		shift::flush(sink);
+		CHECK(file_size(fd) == sink.size());
+		CHECK(shift::detail::ostream_operator_interface<mmap_sink_t>::get_buffer(sink).capacity() == capacity);
+
+		encode_records(sink, n, 2 * n);
+		shift::flush(sink);
+		CHECK(file_size(fd) == sink.size());
+	}
+
+	vector_sink_t expected;
+	encode_records(expected, 0, 2 * n);
+	REQUIRE(file_size(fd) == expected.size());
+
+	shift::mapped_file mapped(fd, shift::mapped_file::random_access);
+	REQUIRE(mapped.size() == expected.size());
+	for (std::size_t i=0; i<mapped.size(); ++i)
+		REQUIRE(mapped.data()[i] == expected.buffer()[i]);
+
+	std::fclose(file);
+}
+
+TEST_CASE( "mmap_buffer: an empty sink can be flushed, cleared and written to"
+         , "[mmap_buffer]")
+{
+	std::FILE* file = std::tmpfile();
+	REQUIRE(file != NULL);
+	const int fd = fileno(file);
+
+	{
+		typedef shift::sink<shift::little_endian, buffer_type> sink_t;
+		sink_t sink(buffer_type::initialization_params(fd, 16));
+		shift::flush(sink);
+		CHECK(file_size(fd) == 0);
+
+		sink.clear();
+		sink << static_cast<shift::uint32_t>(7);
+		shift::flush(sink);
+		CHECK(file_size(fd) == 4);
+
+		sink.clear();
+		CHECK(sink.size() == 0);
+	}
+	CHECK(file_size(fd) == 0);
+
+	std::fclose(file);
+}
+
+TEST_CASE( "mmap_buffer: a source constructed over a mapped file decodes the content"
+         , "[mmap_buffer]")
+{
+	std::FILE* file = std::tmpfile();
+	REQUIRE(file != NULL);
+	const int fd = fileno(file);
+
+	const unsigned int n = 1000;
+	{
+		typedef shift::sink<shift::big_endian, buffer_type> sink_t;
+		sink_t sink(buffer_type::initialization_params(fd, 16));
+		encode_records(sink, 0, n);
+	}
+
+	shift::mapped_file mapped(fd);
+	shift::source<shift::big_endian> source = mapped.make_source<shift::big_endian>();
+	CHECK(source.size() == mapped.size());
+	check_records(source, 0, n);
+
+	std::fclose(file);
+}
+
+TEST_CASE( "mmap_buffer: an empty file can be mapped"
+         , "[mmap_buffer]")
+{
+	std::FILE* file = std::tmpfile();
+	REQUIRE(file != NULL);
+
+	shift::mapped_file mapped(fileno(file));
+	CHECK(mapped.size() == 0);
+	CHECK(mapped.data() == NULL);
+
+	std::fclose(file);
+}
+
+}} // test
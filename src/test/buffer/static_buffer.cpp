@@ -13,7 +13,7 @@ namespace test { namespace {
 		REQUIRE(false);                                                   \
 	} catch(const shift::out_of_range& e) {                               \
 		CHECK(e.value() == index);                                        \
-		CHECK(e.range() == std::make_pair<unsigned int>(0, buffer_size)); \
+		CHECK(e.range() == shift::out_of_range::range_type(0, buffer_size)); \
 	}                                                                     \
 
 TEST_CASE( "allocated memory is cleared on construction", "[static_buffer]" ) {
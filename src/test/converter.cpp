@@ -428,6 +428,40 @@ TEST_CASE( "combined converter (5): scale + offset + offset + scale + scale, enc
 	                             , 0);
 }
 
+TEST_CASE( "combined converters only store the reference to the value and the params of their stages"
+         , "combined converter")
+{
+	typedef shift::scale_converter <double         , shift::int32_t > c1;
+	typedef shift::offset_converter<shift::int32_t , shift::int32_t > c2;
+	typedef shift::type_converter  <shift::int32_t , shift::uint16_t> c3;
+
+	typedef shift::combined_converter<c1, c2, c3> combined_conv_t;
+
+	CHECK(sizeof(combined_conv_t) == sizeof(shift::int64_t) + sizeof(double*) + sizeof(double));
+
+	double value = 12.5;
+	combined_conv_t conv(value, c1::params(4.), c2::params(1000), c3::params());
+	CHECK(conv.encode() == 1050);
+
+	check_converter_encode_decode(conv, value, 1050, 3);
+}
+
+#if __cplusplus >= 201103L
+TEST_CASE( "combined converter (7): any number of stages can be combined with C++11"
+         , "combined converter >> % <<")
+{
+	typedef shift::scale_converter <double         , shift::int32_t> c1;
+	typedef shift::offset_converter<shift::int32_t , shift::int32_t> c2;
+
+	typedef shift::combined_converter<c1, c2, c2, c2, c2, c2, c2> combined_conv_t;
+
+	double value = 2.5;
+	combined_conv_t conv(value, c1::params(2.), 1, 2, 3, 4, 5, 6);
+
+	check_converter_encode_decode(conv, value, 26, 0);
+}
+#endif
+
 TEST_CASE( "writing beyond the capacity of the buffer with a converter causes an out_ot_range exception to be thrown"
          , "converter" )
 {
@@ -461,7 +495,7 @@ TEST_CASE( "trying to extract with a converter beyond the size of a source resul
          , "converter" )
 {
 	const unsigned int buffer_size = 32;
-	shift::byte_type buffer[buffer_size];
+	shift::byte_type buffer[buffer_size] = { 0 };
 	typedef shift::source<shift::little_endian> source_type;
 	typedef shift::scale_converter<double, shift::uint32_t> converter_type;
 
@@ -486,6 +520,38 @@ TEST_CASE( "trying to extract with a converter beyond the size of a source resul
 	}
 }
 
+/*
+ * a converter defined outside of shift: temperatures from -64 degrees in quarter degrees
+ */
+class temperature_converter : public shift::converter<temperature_converter> {
+public:
+	typedef double          decoded_type;
+	typedef shift::uint16_t encoded_type;
+
+	explicit temperature_converter(decoded_type& value) : value(value) {}
+
+	encoded_type encode()                 const { return  static_cast<encoded_type>((value + 64) * 4); }
+	void         decode(encoded_type arg) const { value = arg / 4. - 64; }
+
+private:
+	decoded_type& value;
+};
+
+TEST_CASE( "converters derived from converter are called without virtual functions"
+         , "[converter]")
+{
+	CHECK(sizeof(shift::type_converter<int, shift::uint8_t>) == sizeof(int*));
+	CHECK(sizeof(temperature_converter                     ) == sizeof(double*));
+
+	double value = 21.25;
+	temperature_converter conv(value);
+	check_converter_encode_decode(conv, value, 341,  0);
+	check_converter_encode_decode(conv, value, 341, 13);
+
+	value = -64;
+	check_converter_encode_decode(conv, value,   0,  7);
+}
+
 enum numbers { zero  = 0,
                one   = 1,
                two   = 2,
@@ -0,0 +1,90 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include <shift/detail/byte_swap.hpp>
+#include <shift/detail/utility.hpp>
+
+namespace test { namespace {
+
+typedef std::vector<shift::byte_type> bytes_type;
+
+bytes_type make_bytes(std::size_t n) {
+	bytes_type bytes(n + 1);
+	for (std::size_t i=0; i<bytes.size(); ++i)
+		bytes[i] = static_cast<shift::byte_type>(i * 7 + 3);
+	return bytes;
+}
+
+template<std::size_t Size>
+void check_swap_lanes() {
+	for (std::size_t n_values=0; n_values<80; ++n_values) {
+		CAPTURE(n_values);
+		const std::size_t n_bytes = n_values * Size;
+
+		// unaligned by one byte on purpose
+		const bytes_type source = make_bytes(n_bytes);
+		bytes_type destination(n_bytes + 1, 0);
+		shift::detail::swap_lanes<Size>(&source[1], n_values, &destination[1]);
+
+		CHECK(destination[0] == 0);
+		for (std::size_t i=0; i<n_values; ++i)
+			for (std::size_t j=0; j<Size; ++j)
+				REQUIRE(destination[1 + i * Size + j] == source[1 + i * Size + Size - 1 - j]);
+	}
+}
+
+TEST_CASE( "swap_lanes: reverses the bytes of each value of arrays of 1, 2, 4 and 8 byte values"
+         , "[byte_swap]" )
+{
+	check_swap_lanes<1>();
+	check_swap_lanes<2>();
+	check_swap_lanes<4>();
+	check_swap_lanes<8>();
+}
+
+TEST_CASE( "reverse_block: reverses the order of all bytes of a block"
+         , "[byte_swap]" )
+{
+	for (std::size_t n=0; n<100; ++n) {
+		CAPTURE(n);
+		const bytes_type source = make_bytes(n);
+		bytes_type destination(n + 1, 0);
+		shift::detail::reverse_block(&source[1], n, &destination[1]);
+		for (std::size_t i=0; i<n; ++i)
+			REQUIRE(destination[1 + i] == source[n - i]);
+
+		bytes_type copied(n + 1, 0);
+		shift::detail::reverse_copy(static_cast<const shift::byte_type*>(&source[1]), &source[1] + n, &copied[1]);
+		CHECK(copied == destination);
+	}
+}
+
+TEST_CASE( "encode_values and decode_values convert arrays from and to the given byte order"
+         , "[byte_swap]" )
+{
+	const shift::uint32_t values[] = { 0x01020304, 0xA0B0C0D0, 0xFFFFFFFF, 0, 0x11223344, 0x55667788 };
+	const std::size_t n = sizeof(values) / sizeof(values[0]);
+
+	shift::byte_type big[n * 4];
+	shift::detail::encode_values<shift::big_endian>(values, n, big);
+	for (std::size_t i=0; i<n; ++i) {
+		CHECK(big[i * 4    ] == static_cast<shift::byte_type>(values[i] >> 24));
+		CHECK(big[i * 4 + 3] == static_cast<shift::byte_type>(values[i]      ));
+	}
+
+	shift::byte_type little[n * 4];
+	shift::detail::encode_values<shift::little_endian>(values, n, little);
+	for (std::size_t i=0; i<n; ++i) {
+		CHECK(little[i * 4    ] == static_cast<shift::byte_type>(values[i]      ));
+		CHECK(little[i * 4 + 3] == static_cast<shift::byte_type>(values[i] >> 24));
+	}
+
+	shift::uint32_t decoded[n];
+	shift::detail::decode_values<shift::big_endian>(big, n, decoded);
+	CHECK(std::equal(values, values + n, decoded));
+	shift::detail::decode_values<shift::little_endian>(little, n, decoded);
+	CHECK(std::equal(values, values + n, decoded));
+}
+
+}} // test
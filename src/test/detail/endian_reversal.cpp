@@ -95,4 +95,42 @@ TEST_CASE( "endian_reverse: uint64_t"
 	CHECK( shift::detail::endian_reverse(reversed) == value );
 }
 
+TEST_CASE( "endian_reverse: integral types of the same size as the fixed width types are reversed alike"
+         , "[endian_reverse]" )
+{
+	const unsigned long long value = 0x0102030405060708ULL;
+	CHECK(shift::detail::endian_reverse(value) == 0x0807060504030201ULL);
+
+	const int signed_value = 0x01020304;
+	CHECK(shift::detail::endian_reverse(signed_value) == 0x04030201);
+}
+
+TEST_CASE( "reverse_bytes: the byte order of floating point values is reversed"
+         , "[endian_reverse]" )
+{
+	const double value    = 3.14159;
+	const double reversed = shift::detail::reverse_bytes(value);
+
+	const uint8_t* p_value    = reinterpret_cast<const uint8_t*>(&value   );
+	const uint8_t* p_reversed = reinterpret_cast<const uint8_t*>(&reversed);
+	for (unsigned int i=0; i<sizeof(double); ++i)
+		CHECK(p_value[i] == p_reversed[sizeof(double) - i - 1]);
+
+	CHECK(shift::detail::reverse_bytes(reversed) == value);
+
+	const float f = -2.5f;
+	CHECK(shift::detail::reverse_bytes(shift::detail::reverse_bytes(f)) == f);
+}
+
+TEST_CASE( "system endianness: the compile time byte order matches the byte order of the system"
+         , "[endianness]" )
+{
+	const shift::uint16_t value = 1;
+	const bool is_little_endian = *reinterpret_cast<const shift::uint8_t*>(&value) == 1;
+
+	CHECK(shift::detail::endianness_impl::is_little_endian() == is_little_endian);
+	CHECK(shift::detail::requires_endianness_conversion<shift::little_endian>::value == !is_little_endian);
+	CHECK(shift::detail::requires_endianness_conversion<shift::big_endian   >::value ==  is_little_endian);
+}
+
 }} // test::anonymous
@@ -0,0 +1,106 @@
+#include <catch.hpp>
+
+#include <cstddef>
+#include <vector>
+#include <iterator>
+
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/operator/repeated.hpp>
+#include <shift/operator/universal.hpp>
+#include <shift/types/fixed_width_uint.hpp>
+
+#include <test/utility.hpp>
+
+namespace test { namespace {
+
+template<typename FixedWidthUintType>
+std::vector<FixedWidthUintType> bit_packing_values(unsigned int n) {
+	typedef typename FixedWidthUintType::value_type value_type;
+	std::vector<FixedWidthUintType> values;
+	value_generator generator;
+	for (unsigned int i=0; i<n; ++i) {
+		const shift::uint64_t x = generator();
+		values.push_back(FixedWidthUintType(static_cast<value_type>(i % 5 == 0 ? ~shift::uint64_t(0) : x)));
+	}
+	return values;
+}
+
+template<typename FixedWidthUintType>
+void check_bit_packing(unsigned int n) {
+	const unsigned int num_bits = FixedWidthUintType::num_bits;
+	CAPTURE(num_bits);
+	CAPTURE(n);
+	const std::size_t size = check_repeated_round_trip<shift::bit_packed, shift::big_endian>(bit_packing_values<FixedWidthUintType>(n), 16);
+	CHECK(size == (n < 128 ? 1 : 2) + (n * num_bits + 7) / 8);
+}
+
+TEST_CASE( "bit_packed: the elements follow each other without padding, most significant bit first"
+         , "[bit_packing]")
+{
+	typedef shift::sink<shift::little_endian, shift::vector> sink_type;
+
+	SECTION("uint3_t") {
+		const shift::uint3_t values[] = { shift::uint3_t(1), shift::uint3_t(2), shift::uint3_t(3), shift::uint3_t(4), shift::uint3_t(5) };
+		sink_type sink;
+		sink << shift::orepeated<shift::bit_packed, const shift::uint3_t*>(values, values + 5);
+
+		const shift::byte_type expected[] = { 5, 0x29, 0xCA };
+		REQUIRE(sink.size() == sizeof(expected));
+		for (unsigned int i=0; i<sizeof(expected); ++i)
+			CHECK(sink.buffer()[i] == expected[i]);
+	}
+
+	SECTION("uint12_t") {
+		const shift::uint12_t values[] = { shift::uint12_t(0xABC), shift::uint12_t(0x123), shift::uint12_t(0xFFF) };
+		sink_type sink;
+		sink << shift::orepeated<shift::bit_packed, const shift::uint12_t*>(values, values + 3);
+
+		const shift::byte_type expected[] = { 3, 0xAB, 0xC1, 0x23, 0xFF, 0xF0 };
+		REQUIRE(sink.size() == sizeof(expected));
+		for (unsigned int i=0; i<sizeof(expected); ++i)
+			CHECK(sink.buffer()[i] == expected[i]);
+	}
+}
+
+TEST_CASE( "bit_packed: arrays of fixed_width_uints are decoded to the encoded values"
+         , "[bit_packing]")
+{
+	for (unsigned int n=0; n<140; ++n)
+		check_bit_packing<shift::uint12_t>(n);
+
+	check_bit_packing<shift::uint1_t >(1000);
+	check_bit_packing<shift::uint3_t >(1000);
+	check_bit_packing<shift::uint7_t >(1000);
+	check_bit_packing<shift::uint15_t>(1000);
+	check_bit_packing<shift::fixed_width_uint<shift::uint8_t ,  8> >(1000);
+	check_bit_packing<shift::fixed_width_uint<shift::uint16_t, 16> >(1000);
+	check_bit_packing<shift::fixed_width_uint<shift::uint32_t, 17> >(1000);
+	check_bit_packing<shift::fixed_width_uint<shift::uint32_t, 31> >(1000);
+	check_bit_packing<shift::fixed_width_uint<shift::uint64_t, 33> >(1000);
+	check_bit_packing<shift::fixed_width_uint<shift::uint64_t, 57> >(1000);
+	check_bit_packing<shift::fixed_width_uint<shift::uint64_t, 58> >(1000);
+	check_bit_packing<shift::fixed_width_uint<shift::uint64_t, 64> >(1000);
+}
+
+TEST_CASE( "bit_packed: an array that ends beyond the input throws out_of_range before any element is decoded"
+         , "[bit_packing]")
+{
+	typedef shift::sink  <shift::little_endian, shift::vector> sink_type;
+	typedef shift::source<shift::little_endian>                source_type;
+	typedef std::vector<shift::uint12_t>                       container_type;
+	typedef std::back_insert_iterator<container_type>          inserter_type;
+	typedef shift::irepeated<shift::bit_packed, inserter_type> repeated_type;
+
+	const container_type values = bit_packing_values<shift::uint12_t>(100);
+	sink_type sink;
+	sink << shift::orepeated<shift::bit_packed, container_type::const_iterator>(values.begin(), values.end());
+
+	container_type decoded;
+	source_type source(sink.buffer(), sink.size() - 1);
+	CHECK_THROWS_AS(source >> repeated_type(std::back_inserter(decoded)), const shift::out_of_range&);
+	CHECK(decoded.empty());
+}
+
+}} // test
@@ -0,0 +1,204 @@
+#include <catch.hpp>
+
+#include <vector>
+#include <limits>
+#include <iterator>
+
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/types/converter.hpp>
+#include <shift/types/combined_converter.hpp>
+#include <shift/detail/batch_conversion.hpp>
+#include <shift/operator/repeated.hpp>
+#include <shift/operator/converted_repeated.hpp>
+#include <shift/operator/universal.hpp>
+
+namespace test { namespace {
+
+/*
+ * a converted field is encoded like the field of the values converted one by one, and decoded to the
+ * values the converter decodes one by one
+ */
+template<typename SizeType, typename ConverterType, shift::endianness Endianness>
+void check_converted_repeated( const std::vector<typename ConverterType::decoded_type>& values
+                             , const typename ConverterType::params&                    p) {
+	typedef typename ConverterType::decoded_type                  decoded_type;
+	typedef typename ConverterType::encoded_type                  encoded_type;
+	typedef shift::sink  <Endianness, shift::vector>              sink_type;
+	typedef shift::source<Endianness>                             source_type;
+	typedef std::vector<decoded_type>                             container_type;
+	typedef std::vector<encoded_type>                             encoded_container_type;
+
+	CAPTURE(values.size());
+	encoded_container_type encoded;
+	container_type         expected;
+	for (unsigned int i=0; i<values.size(); ++i) {
+		encoded .push_back(ConverterType::encode(values[i] , p));
+		expected.push_back(ConverterType::decode(encoded[i], p));
+	}
+
+	sink_type copied;
+	copied << shift::orepeated<SizeType, typename encoded_container_type::const_iterator>(encoded.begin(), encoded.end()) << shift::uint8_t(0xAB);
+
+	sink_type sink;
+	sink << shift::orepeated_converted<SizeType, ConverterType, typename container_type::const_iterator>(values.begin(), values.end(), p) << shift::uint8_t(0xAB);
+
+	REQUIRE(sink.size() == copied.size());
+	for (unsigned int i=0; i<sink.size(); ++i)
+		CHECK(sink.buffer()[i] == copied.buffer()[i]);
+
+	container_type decoded;
+	shift::uint8_t end = 0;
+	source_type source(sink.buffer(), sink.size());
+	source >> shift::irepeated_converted<SizeType, ConverterType, std::back_insert_iterator<container_type> >(std::back_inserter(decoded), p) >> end;
+	CHECK(decoded == expected);
+	CHECK(end == 0xAB);
+}
+
+template<typename SizeType, typename ConverterType>
+void check_converted_repeated( const std::vector<typename ConverterType::decoded_type>& values
+                             , const typename ConverterType::params&                    p) {
+	check_converted_repeated<SizeType, ConverterType, shift::little_endian>(values, p);
+	check_converted_repeated<SizeType, ConverterType, shift::big_endian   >(values, p);
+}
+
+TEST_CASE( "converted repeated fields: float samples scaled to int16_t"
+         , "[converted_repeated]")
+{
+	typedef shift::scale_converter<float, shift::int16_t, float> converter_type;
+
+	std::vector<float> samples;
+	for (unsigned int n=0; n<600; n+=37) {
+		check_converted_repeated<shift::uint16_t       , converter_type>(samples, 100.f);
+		check_converted_repeated<shift::variable_length, converter_type>(samples, 0.5f);
+		while (samples.size() < n)
+			samples.push_back(static_cast<float>(samples.size() % 651) * 0.5f - 162.25f);
+	}
+}
+
+TEST_CASE( "converted repeated fields: clamping saturates values beyond the bounds"
+         , "[converted_repeated]")
+{
+	typedef shift::clamp_converter<float, shift::int16_t>  converter_type;
+	typedef shift::sink  <shift::little_endian, shift::vector> sink_type;
+	typedef shift::source<shift::little_endian>                source_type;
+
+	const float values[] = { -1e9f, -32769.f, -32768.f, -1.5f, 0.f, 1.5f, 32767.f, 32768.f, 1e9f, 7.75f };
+	const shift::int16_t expected[] = { -32768, -32768, -32768, -1, 0, 1, 32767, 32767, 32767, 7 };
+
+	sink_type sink;
+	sink << shift::orepeated_converted<shift::uint8_t, converter_type, const float*>(values, values + 10, converter_type::params(-32768.f, 32767.f));
+
+	std::vector<shift::int16_t> encoded;
+	source_type source(sink.buffer(), sink.size());
+	source >> shift::irepeated<shift::uint8_t, std::back_insert_iterator<std::vector<shift::int16_t> > >(std::back_inserter(encoded));
+	REQUIRE(encoded.size() == 10);
+	for (unsigned int i=0; i<10; ++i)
+		CHECK(encoded[i] == expected[i]);
+
+	std::vector<float> samples(values, values + 10);
+	check_converted_repeated<shift::uint32_t, converter_type>(samples, converter_type::params(-100.f, 100.f));
+}
+
+TEST_CASE( "converted repeated fields: values beyond int16_t and NaN are encoded alike in vectorized blocks and the remainder"
+         , "[converted_repeated]")
+{
+	typedef shift::scale_converter<float, shift::int16_t, float> scale_type;
+	typedef shift::clamp_converter<float, shift::int16_t>        clamp_type;
+
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	const float inf = std::numeric_limits<float>::infinity();
+	const float values[]          = { 40000.f, -40000.f, 1e10f, -1e10f, 2147483648.f, -2147483904.f, inf, -inf, nan, 32767.5f, -32768.5f, 12.75f };
+	const shift::int16_t scaled[] = { 32767  , -32768  , 32767, -32768, 32767       , -32768       , 32767, -32768, 0, 32767  , -32768  , 12     };
+
+	const scale_type::params scale(1.f);
+	const clamp_type::params clamp(-1e20f, 1e20f);
+	for (unsigned int k=0; k<sizeof(values)/sizeof(values[0]); ++k) {
+		CAPTURE(values[k]);
+		CHECK(scale_type::encode(values[k], scale) == scaled[k]);
+		CHECK(clamp_type::encode(values[k], clamp) == scaled[k]);
+
+		// 8 values for the vector kernels followed by 9 for the scalar remainder
+		const std::vector<float> samples(17, values[k]);
+		std::vector<shift::int16_t> encoded(samples.size());
+		shift::detail::encode_batch<scale_type>(&samples[0], samples.size(), scale, &encoded[0]);
+		for (unsigned int i=0; i<encoded.size(); ++i)
+			CHECK(encoded[i] == scaled[k]);
+		shift::detail::encode_batch<clamp_type>(&samples[0], samples.size(), clamp, &encoded[0]);
+		for (unsigned int i=0; i<encoded.size(); ++i)
+			CHECK(encoded[i] == scaled[k]);
+	}
+
+	std::vector<float> samples;
+	for (unsigned int i=0; i<100; ++i)
+		samples.push_back(values[(i * 5) % (sizeof(values)/sizeof(values[0]))]);
+	check_converted_repeated<shift::uint16_t, scale_type>(samples, scale);
+	check_converted_repeated<shift::uint16_t, clamp_type>(samples, clamp_type::params(-100.f, 100.f));
+}
+
+TEST_CASE( "converted repeated fields: combined converters and size tags of block formats"
+         , "[converted_repeated]")
+{
+	typedef shift::scale_converter <double        , shift::int32_t> scale_type;
+	typedef shift::offset_converter<shift::int32_t, shift::int32_t> offset_type;
+	typedef shift::combined_converter<scale_type, offset_type>      converter_type;
+
+	std::vector<double> prices;
+	for (unsigned int i=0; i<1000; ++i)
+		prices.push_back(100. + (i % 17) * 0.25 - (i % 5) * 0.5);
+
+	const converter_type::params p(scale_type::params(4.), offset_type::params(-400));
+	check_converted_repeated<shift::uint16_t      , converter_type>(prices, p);
+	check_converted_repeated<shift::delta_coding  , converter_type>(prices, p);
+	check_converted_repeated<shift::stream_vbyte  , converter_type>(prices, p);
+	check_converted_repeated<shift::delta_coding  , converter_type>(std::vector<double>(), p);
+}
+
+TEST_CASE( "converted repeated fields: fields without size field and with a static size are decoded into arrays"
+         , "[converted_repeated]")
+{
+	typedef shift::offset_converter<int, shift::uint8_t>           converter_type;
+	typedef shift::sink  <shift::big_endian, shift::vector>        sink_type;
+	typedef shift::source<shift::big_endian>                       source_type;
+
+	const int values[] = { -100, -1, 0, 1, 100, 155 };
+
+	sink_type sink;
+	sink << shift::orepeated_converted<shift::no_size_field, converter_type, const int*>(values, values + 6, 100);
+	REQUIRE(sink.size() == 6);
+	CHECK(sink.buffer()[0] == 0);
+	CHECK(sink.buffer()[5] == 255);
+
+	int decoded[6] = {};
+	source_type source(sink.buffer(), sink.size());
+	source >> shift::irepeated_converted<shift::static_size<6>, converter_type, int*>(decoded, 100);
+	for (unsigned int i=0; i<6; ++i)
+		CHECK(decoded[i] == values[i]);
+
+	int first[4] = {};
+	source = source_type(sink.buffer(), sink.size());
+	source >> shift::irepeated_converted<shift::no_size_field, converter_type, int*>(first, 4, 100);
+	for (unsigned int i=0; i<4; ++i)
+		CHECK(first[i] == values[i]);
+}
+
+TEST_CASE( "converted repeated fields: a field that ends beyond the input throws out_of_range"
+         , "[converted_repeated]")
+{
+	typedef shift::scale_converter<float, shift::int16_t, float>   converter_type;
+	typedef shift::sink  <shift::little_endian, shift::vector>     sink_type;
+	typedef shift::source<shift::little_endian>                    source_type;
+	typedef std::back_insert_iterator<std::vector<float> >         inserter_type;
+	typedef shift::irepeated_converted<shift::uint32_t, converter_type, inserter_type> repeated_type;
+
+	const std::vector<float> values(1000, 1.5f);
+	sink_type sink;
+	sink << shift::orepeated_converted<shift::uint32_t, converter_type, std::vector<float>::const_iterator>(values.begin(), values.end(), 10.f);
+
+	std::vector<float> decoded;
+	source_type source(sink.buffer(), sink.size() - 1);
+	CHECK_THROWS_AS(source >> repeated_type(std::back_inserter(decoded), 10.f), const shift::out_of_range&);
+}
+
+}} // test
@@ -0,0 +1,120 @@
+#include <catch.hpp>
+
+#include <vector>
+#include <iterator>
+
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/operator/repeated.hpp>
+#include <shift/operator/universal.hpp>
+
+#include <test/utility.hpp>
+
+namespace test { namespace {
+
+template<typename SizeType, typename IntType>
+void check_delta_coding(const std::vector<IntType>& values) {
+	check_repeated_round_trip<SizeType, shift::little_endian>(values, 7);
+}
+
+TEST_CASE( "delta coding: the first value and the differences are encoded as zig zag var uints"
+         , "[delta_coding]")
+{
+	typedef shift::sink<shift::big_endian, shift::vector> sink_type;
+	const shift::int32_t values[] = { 100, 101, 103, 103, 90 };
+
+	SECTION("delta_coding") {
+		sink_type sink;
+		sink << shift::orepeated<shift::delta_coding, const shift::int32_t*>(values, values + 5);
+
+		const shift::byte_type expected[] = { 5, 0xC8, 0x01, 2, 4, 0, 25 };
+		REQUIRE(sink.size() == sizeof(expected));
+		for (unsigned int i=0; i<sizeof(expected); ++i)
+			CHECK(sink.buffer()[i] == expected[i]);
+	}
+
+	SECTION("delta_of_delta_coding") {
+		sink_type sink;
+		sink << shift::orepeated<shift::delta_of_delta_coding, const shift::int32_t*>(values, values + 5);
+
+		const shift::byte_type expected[] = { 5, 0xC8, 0x01, 0xC5, 0x01, 2, 3, 25 };
+		REQUIRE(sink.size() == sizeof(expected));
+		for (unsigned int i=0; i<sizeof(expected); ++i)
+			CHECK(sink.buffer()[i] == expected[i]);
+	}
+}
+
+TEST_CASE( "delta coding: sequences are decoded to the encoded values"
+         , "[delta_coding]")
+{
+	std::vector<shift::uint32_t> ids;
+	std::vector<shift::int64_t > timestamps;
+	value_generator generator;
+	for (unsigned int i=0; i<5000; ++i) {
+		const shift::uint32_t x = static_cast<shift::uint32_t>(generator());
+		ids       .push_back((ids.empty() ? 0 : ids.back()) + x % 1000);
+		timestamps.push_back(1476000000000000000LL + i * 1000000LL + (x % 7) - 3);
+	}
+	check_delta_coding<shift::delta_coding         >(ids);
+	check_delta_coding<shift::delta_of_delta_coding>(ids);
+	check_delta_coding<shift::delta_coding         >(timestamps);
+	check_delta_coding<shift::delta_of_delta_coding>(timestamps);
+
+	std::vector<shift::uint64_t> extremes;
+	extremes.push_back(0);
+	extremes.push_back(~shift::uint64_t(0));
+	extremes.push_back(1);
+	extremes.push_back(shift::uint64_t(1) << 63);
+	check_delta_coding<shift::delta_coding         >(extremes);
+	check_delta_coding<shift::delta_of_delta_coding>(extremes);
+
+	std::vector<shift::int8_t> bytes;
+	for (int i=0; i<300; ++i)
+		bytes.push_back(static_cast<shift::int8_t>(i * 37));
+	check_delta_coding<shift::delta_coding         >(bytes);
+	check_delta_coding<shift::delta_of_delta_coding>(bytes);
+
+	check_delta_coding<shift::delta_coding>(std::vector<shift::uint16_t>());
+}
+
+TEST_CASE( "delta coding: timestamps at a constant interval take one byte per value with delta_of_delta_coding"
+         , "[delta_coding]")
+{
+	typedef shift::sink<shift::little_endian, shift::vector> sink_type;
+	typedef std::vector<shift::int64_t>                      container_type;
+
+	container_type timestamps;
+	for (unsigned int i=0; i<1000; ++i)
+		timestamps.push_back(1476000000000000000LL + i * 1000000LL);
+
+	sink_type sink;
+	sink << shift::orepeated<shift::delta_of_delta_coding, container_type::const_iterator>(timestamps.begin(), timestamps.end());
+
+	// size, first value, second difference to the first, 998 zeros
+
+	CHECK(sink.size() == 2 + 9 + 9 + 998);
+}
+
+TEST_CASE( "delta coding: a sequence that ends beyond the input throws out_of_range"
+         , "[delta_coding]")
+{
+	typedef shift::sink  <shift::little_endian, shift::vector> sink_type;
+	typedef shift::source<shift::little_endian>                source_type;
+	typedef std::vector<shift::uint32_t>                       container_type;
+	typedef std::back_insert_iterator<container_type>          inserter_type;
+	typedef shift::irepeated<shift::delta_coding, inserter_type> repeated_type;
+
+	container_type values;
+	for (unsigned int i=0; i<100; ++i)
+		values.push_back(i * 1000);
+
+	sink_type sink;
+	sink << shift::orepeated<shift::delta_coding, container_type::const_iterator>(values.begin(), values.end());
+
+	container_type decoded;
+	source_type source(sink.buffer(), sink.size() - 1);
+	CHECK_THROWS_AS(source >> repeated_type(std::back_inserter(decoded)), const shift::out_of_range&);
+}
+
+}} // test
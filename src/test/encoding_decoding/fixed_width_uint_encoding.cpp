@@ -409,7 +409,7 @@ TEST_CASE( "trying to stream out fixed_width_uint<> values beyond the size of a
 	typedef shift::fixed_width_uint<unsigned short, 13> uint_t;
 	const unsigned int buffer_capacity = 32;
 	typedef shift::source <shift::little_endian> source_type;
-	uint8_t buffer[buffer_capacity];
+	uint8_t buffer[buffer_capacity] = { 0 };
 	source_type source(buffer, buffer_capacity);
 	uint_t v;
 
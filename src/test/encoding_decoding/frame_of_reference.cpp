@@ -0,0 +1,145 @@
+#include <catch.hpp>
+
+#include <vector>
+#include <iterator>
+
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/operator/repeated.hpp>
+#include <shift/operator/universal.hpp>
+
+#include <test/utility.hpp>
+
+namespace test { namespace {
+
+template<typename IntType>
+void check_frame_of_reference(const std::vector<IntType>& values) {
+	check_repeated_round_trip<shift::frame_of_reference        , shift::little_endian>(values, 7);
+	check_repeated_round_trip<shift::patched_frame_of_reference, shift::little_endian>(values, 7);
+}
+
+template<typename SizeType>
+std::size_t frame_of_reference_size(const std::vector<shift::uint32_t>& values) {
+	shift::sink<shift::little_endian, shift::vector> sink;
+	sink << shift::orepeated<SizeType, std::vector<shift::uint32_t>::const_iterator>(values.begin(), values.end());
+	return sink.size();
+}
+
+TEST_CASE( "frame_of_reference: blocks start with their minimum and the width of the packed offsets"
+         , "[frame_of_reference]")
+{
+	typedef shift::sink<shift::big_endian, shift::vector> sink_type;
+
+	SECTION("frame_of_reference") {
+		const shift::uint32_t values[] = { 100, 103, 101, 107 };
+		sink_type sink;
+		sink << shift::orepeated<shift::frame_of_reference, const shift::uint32_t*>(values, values + 4);
+
+		const shift::byte_type expected[] = { 4, 100, 3, 0x0C, 0xF0 };
+		REQUIRE(sink.size() == sizeof(expected));
+		for (unsigned int i=0; i<sizeof(expected); ++i)
+			CHECK(sink.buffer()[i] == expected[i]);
+	}
+
+	SECTION("patched_frame_of_reference") {
+		const shift::uint32_t values[] = { 0, 1, 0, 1, 0, 1, 0, 1000 };
+		sink_type sink;
+		sink << shift::orepeated<shift::patched_frame_of_reference, const shift::uint32_t*>(values, values + 8);
+
+		// minimum, width, one exception at index 7 with 1000 >> 1, the low bits
+
+		const shift::byte_type expected[] = { 8, 0, 1, 1, 7, 0xF4, 0x03, 0x54 };
+		REQUIRE(sink.size() == sizeof(expected));
+		for (unsigned int i=0; i<sizeof(expected); ++i)
+			CHECK(sink.buffer()[i] == expected[i]);
+	}
+}
+
+TEST_CASE( "frame_of_reference: sequences are decoded to the encoded values"
+         , "[frame_of_reference]")
+{
+	std::vector<shift::uint32_t> buckets;
+	std::vector<shift::int64_t > signed_values;
+	std::vector<shift::int16_t > shorts;
+	value_generator generator;
+	for (unsigned int i=0; i<5000; ++i) {
+		const shift::uint32_t x = static_cast<shift::uint32_t>(generator());
+		buckets      .push_back(1000000 + (i / 64) * 5000 + x % 300 + (x % 97 == 0 ? x : 0));
+		signed_values.push_back(static_cast<shift::int64_t>(x % 2000) - 1000);
+		shorts       .push_back(static_cast<shift::int16_t>(x));
+	}
+	check_frame_of_reference(buckets);
+	check_frame_of_reference(signed_values);
+	check_frame_of_reference(shorts);
+
+	std::vector<shift::int64_t> extremes;
+	for (unsigned int i=0; i<70; ++i) {
+		extremes.push_back(i);
+		extremes.push_back(i % 3 == 0 ? -9223372036854775807LL - 1 : 9223372036854775807LL);
+	}
+	check_frame_of_reference(extremes);
+
+	std::vector<shift::uint8_t> bytes;
+	for (unsigned int n=0; n<140; ++n) {
+		check_frame_of_reference(bytes);
+		bytes.push_back(static_cast<shift::uint8_t>(n * 37));
+	}
+
+	check_frame_of_reference(std::vector<shift::uint64_t>(100, 12345));
+}
+
+TEST_CASE( "frame_of_reference: patching keeps outliers from widening the packed offsets"
+         , "[frame_of_reference]")
+{
+	std::vector<shift::uint32_t> values;
+	for (unsigned int i=0; i<640; ++i)
+		values.push_back(500000 + i % 16 + (i % 64 == 10 ? 4000000000u : 0));
+
+	// 10 blocks of the 3 byte minimum and the width, then 32 bit offsets or, patched, the number of
+	// exceptions, an index with 4 bytes of high bits and 4 bit offsets
+
+	CHECK(frame_of_reference_size<shift::frame_of_reference        >(values) == 2 + 10 * (3 + 1 + 64 * 32 / 8));
+	CHECK(frame_of_reference_size<shift::patched_frame_of_reference>(values) == 2 + 10 * (3 + 1 + 1 + 1 + 4 + 64 * 4 / 8));
+}
+
+TEST_CASE( "frame_of_reference: malformed and truncated blocks throw out_of_range"
+         , "[frame_of_reference]")
+{
+	typedef shift::sink  <shift::little_endian, shift::vector> sink_type;
+	typedef shift::source<shift::little_endian>                source_type;
+	typedef std::vector<shift::uint32_t>                       container_type;
+	typedef std::back_insert_iterator<container_type>          inserter_type;
+
+	container_type values;
+	for (unsigned int i=0; i<100; ++i)
+		values.push_back(i * 1000);
+
+	SECTION("truncated") {
+		typedef shift::irepeated<shift::frame_of_reference, inserter_type> repeated_type;
+		sink_type sink;
+		sink << shift::orepeated<shift::frame_of_reference, container_type::const_iterator>(values.begin(), values.end());
+
+		container_type decoded;
+		source_type source(sink.buffer(), sink.size() - 1);
+		CHECK_THROWS_AS(source >> repeated_type(std::back_inserter(decoded)), const shift::out_of_range&);
+	}
+
+	SECTION("width") {
+		typedef shift::irepeated<shift::frame_of_reference, inserter_type> repeated_type;
+		const shift::byte_type encoded[] = { 2, 0, 33, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+		container_type decoded;
+		source_type source(encoded, sizeof(encoded));
+		CHECK_THROWS_AS(source >> repeated_type(std::back_inserter(decoded)), const shift::out_of_range&);
+	}
+
+	SECTION("exception index") {
+		typedef shift::irepeated<shift::patched_frame_of_reference, inserter_type> repeated_type;
+		const shift::byte_type encoded[] = { 2, 0, 1, 1, 2, 1, 0 };
+		container_type decoded;
+		source_type source(encoded, sizeof(encoded));
+		CHECK_THROWS_AS(source >> repeated_type(std::back_inserter(decoded)), const shift::out_of_range&);
+	}
+}
+
+}} // test
@@ -5,11 +5,14 @@
 #include <iostream>
 #include <vector>
 #include <list>
+#include <string>
+#include <algorithm>
 
 #include <shift/buffer/static_buffer.hpp>
 #include <shift/sink.hpp>
 #include <shift/source.hpp>
 #include <shift/operator/repeated.hpp>
+#include <shift/operator/string.hpp>
 #include <shift/operator/universal.hpp>
 #include <shift/types/var_int.hpp>
 
@@ -513,6 +516,83 @@ TEST_CASE( "trying to stream out repeated values beyond the size of a source res
 	}
 }
 
+template<typename ValueType, shift::endianness Endianness>
+void check_block_copy_equals_element_wise_copy() {
+	typedef std::vector<ValueType> vector_type;
+	typedef std::list<ValueType>   list_type;
+	typedef shift::sink<Endianness, shift::static_buffer<4096> > sink_type;
+	typedef shift::source<Endianness> source_type;
+
+	vector_type values;
+	for (unsigned int i=0; i<300; ++i)
+		values.push_back(static_cast<ValueType>(i * 37 + 0.5));
+	const list_type list(values.begin(), values.end());
+
+	sink_type block_sink;
+	sink_type element_sink;
+	block_sink   << shift::uint8_t(1) << shift::orepeated<shift::uint16_t, const ValueType*>(&values[0], &values[0] + values.size());
+	element_sink << shift::uint8_t(1) << shift::orepeated<shift::uint16_t, typename list_type::const_iterator>(list.begin(), list.end());
+
+	REQUIRE(block_sink.size() == element_sink.size());
+	for (unsigned int i=0; i<block_sink.size(); ++i)
+		REQUIRE(block_sink.buffer()[i] == element_sink.buffer()[i]);
+
+	source_type source(block_sink.buffer(), block_sink.size());
+	vector_type decoded(1, ValueType(5));
+	shift::uint8_t prefix = 0;
+	source >> prefix >> shift::irepeated<shift::uint16_t, std::back_insert_iterator<vector_type> >(std::back_inserter(decoded));
+	REQUIRE(decoded.size() == values.size() + 1);
+	CHECK(decoded[0] == ValueType(5));
+	CHECK(std::equal(values.begin(), values.end(), decoded.begin() + 1));
+
+	ValueType array[300];
+	source >> shift::buffer_position(1) >> shift::irepeated<shift::uint16_t, ValueType*>(array);
+	CHECK(std::equal(values.begin(), values.end(), array));
+}
+
+TEST_CASE( "repeated arithmetic values in contiguous arrays are encoded and decoded as a block with the same result as "
+           "element by element"
+         , "[repeated]" )
+{
+	check_block_copy_equals_element_wise_copy<shift::int8_t  , shift::big_endian   >();
+	check_block_copy_equals_element_wise_copy<shift::uint16_t, shift::big_endian   >();
+	check_block_copy_equals_element_wise_copy<shift::int32_t , shift::big_endian   >();
+	check_block_copy_equals_element_wise_copy<shift::uint64_t, shift::big_endian   >();
+	check_block_copy_equals_element_wise_copy<float          , shift::big_endian   >();
+	check_block_copy_equals_element_wise_copy<double         , shift::big_endian   >();
+	check_block_copy_equals_element_wise_copy<shift::int8_t  , shift::little_endian>();
+	check_block_copy_equals_element_wise_copy<shift::uint16_t, shift::little_endian>();
+	check_block_copy_equals_element_wise_copy<shift::int32_t , shift::little_endian>();
+	check_block_copy_equals_element_wise_copy<shift::uint64_t, shift::little_endian>();
+	check_block_copy_equals_element_wise_copy<float          , shift::little_endian>();
+	check_block_copy_equals_element_wise_copy<double         , shift::little_endian>();
+}
+
+TEST_CASE( "when decoding into a std::vector the vector is reserved, a size beyond the input throws out_of_range"
+         , "[repeated]" )
+{
+	typedef std::vector<std::string> string_container_type;
+	typedef std::vector<double>      double_container_type;
+	typedef shift::sink<shift::little_endian, shift::static_buffer<1024> > sink_type;
+	typedef shift::source<shift::little_endian> source_type;
+
+	const string_container_type strings(50, "abc");
+	sink_type sink;
+	sink << shift::orepeated<shift::uint8_t, string_container_type::const_iterator>(strings.begin(), strings.end())
+	     << shift::uint32_t(0xFFFFFFFF);
+
+	source_type source(sink.buffer(), sink.size());
+	string_container_type decoded;
+	source >> shift::irepeated<shift::uint8_t, std::back_insert_iterator<string_container_type> >(std::back_inserter(decoded));
+	CHECK(decoded == strings);
+	CHECK(decoded.capacity() == strings.size());
+
+	typedef shift::irepeated<shift::uint32_t, std::back_insert_iterator<double_container_type> > irepeated_type;
+	double_container_type doubles;
+	CHECK_THROWS_AS( source >> irepeated_type(std::back_inserter(doubles)), const shift::out_of_range& );
+	CHECK(doubles.empty());
+}
+
 #undef DEFINE_ARRAY
 #undef DEFINE_STD_VECTOR
 
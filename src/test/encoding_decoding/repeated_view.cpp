@@ -0,0 +1,165 @@
+#include <catch.hpp>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <iterator>
+
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/streaming_source.hpp>
+#include <shift/reader/reader.hpp>
+#include <shift/reader/istream_reader.hpp>
+#include <shift/operator/repeated.hpp>
+#include <shift/operator/repeated_view.hpp>
+#include <shift/operator/var_int.hpp>
+#include <shift/operator/universal.hpp>
+#include <shift/types/var_int.hpp>
+#include <shift/types/fixed_width_uint.hpp>
+
+#include <test/utility.hpp>
+
+namespace test { namespace {
+
+template<typename SizeType, typename T>
+void check_repeated_view(const std::vector<T>& values) {
+	typedef shift::sink  <shift::little_endian, shift::vector> sink_type;
+	typedef shift::source<shift::little_endian>                source_type;
+	typedef shift::repeated_view<T, shift::little_endian>      view_type;
+
+	CAPTURE(values.size());
+	sink_type sink;
+	sink << shift::orepeated<SizeType, typename std::vector<T>::const_iterator>(values.begin(), values.end()) << shift::uint8_t(0xAB);
+
+	view_type      view;
+	shift::uint8_t end = 0;
+	source_type source(sink.buffer(), sink.size());
+	source >> shift::irepeated_view<SizeType, view_type>(view) >> end;
+	CHECK(end == 0xAB);
+	REQUIRE(view.size() == values.size());
+
+	std::vector<T> decoded;
+	for (typename view_type::const_iterator it = view.begin(); it != view.end(); ++it)
+		decoded.push_back(*it);
+	CHECK(decoded == values);
+
+	// every other element is skipped without being decoded
+
+	unsigned int i = 0;
+	for (typename view_type::const_iterator it = view.begin(); it != view.end(); ++it, ++i)
+		if (i % 2 == 1)
+			CHECK((*it == values[i]));
+}
+
+TEST_CASE( "repeated_view: elements are decoded when the iterators are dereferenced"
+         , "[repeated_view]")
+{
+	std::vector<shift::uint32_t>                 ints;
+	std::vector<shift::var_int<shift::int64_t> > var_ints;
+	std::vector<shift::uint12_t>                 samples;
+	std::vector<double>                          doubles;
+	value_generator generator;
+	for (unsigned int i=0; i<300; ++i) {
+		const shift::uint32_t x = static_cast<shift::uint32_t>(generator());
+		ints    .push_back(x);
+		var_ints.push_back(shift::var_int<shift::int64_t>(static_cast<shift::int32_t>(x) >> (x % 32)));
+		samples .push_back(shift::uint12_t(static_cast<shift::uint16_t>(x)));
+		doubles .push_back(x / 7.0);
+	}
+
+	check_repeated_view<shift::uint16_t       >(ints);
+	check_repeated_view<shift::variable_length>(var_ints);
+	check_repeated_view<shift::uint8_t        >(std::vector<shift::uint12_t>(samples.begin(), samples.begin() + 200));
+	check_repeated_view<shift::uint32_t       >(doubles);
+	check_repeated_view<shift::variable_length>(std::vector<shift::var_int<shift::int64_t> >());
+}
+
+TEST_CASE( "repeated_view: fields are skipped up to the following field"
+         , "[repeated_view]")
+{
+	typedef shift::sink  <shift::big_endian, shift::vector>         sink_type;
+	typedef shift::source<shift::big_endian>                        source_type;
+	typedef shift::var_int<shift::uint32_t>                         var_int_type;
+	typedef shift::repeated_view<shift::uint16_t, shift::big_endian> fixed_view_type;
+	typedef shift::repeated_view<var_int_type   , shift::big_endian> var_int_view_type;
+	typedef shift::irepeated_view<shift::variable_length, var_int_view_type> var_int_field_type;
+
+	const shift::uint16_t fixed  [] = { 1, 2, 3, 0xABCD };
+	const var_int_type    var_ints[] = { var_int_type(1), var_int_type(300), var_int_type(70000) };
+
+	sink_type sink;
+	sink << shift::orepeated<shift::no_size_field, const shift::uint16_t*>(fixed, fixed + 4)
+	     << shift::orepeated<shift::variable_length, const var_int_type*>(var_ints, var_ints + 3)
+	     << shift::orepeated<shift::no_size_field, const shift::uint16_t*>(fixed, fixed + 2)
+	     << shift::uint8_t(0xAB);
+
+	fixed_view_type   a, c;
+	var_int_view_type b;
+	shift::uint8_t    end = 0;
+	source_type source(sink.buffer(), sink.size());
+	source >> shift::irepeated_view<shift::no_size_field, fixed_view_type>(a, 4)
+	       >> var_int_field_type(b)
+	       >> shift::irepeated_view<shift::static_size<2>, fixed_view_type>(c)
+	       >> end;
+	CHECK(end == 0xAB);
+
+	fixed_view_type::const_iterator it = a.begin();
+	std::advance(it, 3);
+	CHECK(*it == 0xABCD);
+	CHECK(**b.begin() == 1u);
+	CHECK(**++b.begin() == 300u);
+	CHECK(c.size() == 2);
+	CHECK(*++c.begin() == 2);
+
+	source = source_type(sink.buffer(), 10);
+	source >> shift::irepeated_view<shift::no_size_field, fixed_view_type>(a, 4);
+	CHECK_THROWS_AS(source >> var_int_field_type(b), const shift::out_of_range&);
+}
+
+TEST_CASE( "repeated_view: var int fields are skipped from sources with a reader"
+         , "[repeated_view]")
+{
+	typedef shift::sink<shift::little_endian, shift::vector>           sink_type;
+	typedef shift::var_int<shift::uint64_t>                            var_int_type;
+	typedef shift::repeated_view<var_int_type, shift::little_endian>   view_type;
+
+	std::vector<var_int_type> values;
+	for (unsigned int i=0; i<1000; ++i)
+		values.push_back(var_int_type(shift::uint64_t(i) << (i % 40)));
+
+	sink_type sink;
+	sink << shift::orepeated<shift::variable_length, std::vector<var_int_type>::const_iterator>(values.begin(), values.end());
+
+	std::istringstream stream(std::string(reinterpret_cast<const char*>(sink.buffer()), sink.size()));
+	shift::istream_reader reader(stream);
+	shift::streaming_source<shift::little_endian> streaming(reader, 16);
+	view_type view;
+	streaming >> shift::irepeated_view<shift::variable_length, view_type>(view);
+
+	std::vector<var_int_type> decoded(view.begin(), view.end());
+	CHECK(decoded == values);
+}
+
+TEST_CASE( "repeated_view: var int fields at the end of the input do not wait for further bytes"
+         , "[repeated_view]")
+{
+	typedef shift::var_int<shift::uint64_t>                            var_int_type;
+	typedef shift::repeated_view<var_int_type, shift::little_endian>   view_type;
+
+	const shift::byte_type data[] = { 3, 0xAC, 0x02, 0x01, 0x01 };
+	open_pipe_reader reader(data, sizeof(data));
+	shift::streaming_source<shift::little_endian> streaming(reader, 16);
+	view_type view;
+	streaming >> shift::irepeated_view<shift::variable_length, view_type>(view);
+	CHECK(reader.n_blocking_reads == 0);
+
+	std::vector<var_int_type> decoded(view.begin(), view.end());
+	REQUIRE(decoded.size() == 3);
+	CHECK(*decoded[0] == 300);
+	CHECK(*decoded[1] == 1);
+	CHECK(*decoded[2] == 1);
+}
+
+}} // test
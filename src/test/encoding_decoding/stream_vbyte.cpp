@@ -0,0 +1,81 @@
+#include <catch.hpp>
+
+#include <vector>
+#include <iterator>
+
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/operator/repeated.hpp>
+#include <shift/operator/universal.hpp>
+
+#include <test/utility.hpp>
+
+namespace test { namespace {
+
+template<typename IntType>
+std::vector<IntType> stream_vbyte_values(unsigned int n) {
+	std::vector<IntType> values;
+	value_generator generator;
+	for (unsigned int i=0; i<n; ++i) {
+		const shift::uint32_t x = static_cast<shift::uint32_t>(generator());
+		values.push_back(static_cast<IntType>(x >> (8 * (x % 4))));
+	}
+	return values;
+}
+
+template<typename IntType>
+void check_stream_vbyte(unsigned int n) {
+	check_repeated_round_trip<shift::stream_vbyte, shift::big_endian>(stream_vbyte_values<IntType>(n), 16);
+}
+
+TEST_CASE( "stream_vbyte: the control bytes with 2 bit length codes precede the little endian data bytes"
+         , "[stream_vbyte]")
+{
+	typedef shift::sink<shift::big_endian, shift::vector> sink_type;
+
+	const shift::uint32_t values[] = { 1, 256, 65536, 16777216, 7 };
+	sink_type sink;
+	sink << shift::orepeated<shift::stream_vbyte, const shift::uint32_t*>(values, values + 5);
+
+	const shift::byte_type expected[] = { 5, 0xE4, 0x00, 1, 0, 1, 0, 0, 1, 0, 0, 0, 1, 7 };
+	REQUIRE(sink.size() == sizeof(expected));
+	for (unsigned int i=0; i<sizeof(expected); ++i)
+		CHECK(sink.buffer()[i] == expected[i]);
+}
+
+TEST_CASE( "stream_vbyte: arrays of integers of up to 4 bytes are decoded to the encoded values"
+         , "[stream_vbyte]")
+{
+	for (unsigned int n=0; n<70; ++n)
+		check_stream_vbyte<shift::uint32_t>(n);
+
+	check_stream_vbyte<shift::uint32_t>(10000);
+	check_stream_vbyte<shift::int32_t >(10000);
+	check_stream_vbyte<shift::uint16_t>(1000);
+}
+
+TEST_CASE( "stream_vbyte: an array that ends beyond the input throws out_of_range before any element is decoded"
+         , "[stream_vbyte]")
+{
+	typedef shift::sink  <shift::little_endian, shift::vector> sink_type;
+	typedef shift::source<shift::little_endian>                source_type;
+	typedef std::vector<shift::uint32_t>                       container_type;
+	typedef std::back_insert_iterator<container_type>          inserter_type;
+	typedef shift::irepeated<shift::stream_vbyte, inserter_type> repeated_type;
+
+	const container_type values = stream_vbyte_values<shift::uint32_t>(100);
+	sink_type sink;
+	sink << shift::orepeated<shift::stream_vbyte, container_type::const_iterator>(values.begin(), values.end());
+
+	container_type decoded;
+	source_type source(sink.buffer(), sink.size() - 1);
+	CHECK_THROWS_AS(source >> repeated_type(std::back_inserter(decoded)), const shift::out_of_range&);
+	CHECK(decoded.empty());
+
+	source = source_type(sink.buffer(), 10);
+	CHECK_THROWS_AS(source >> repeated_type(std::back_inserter(decoded)), const shift::out_of_range&);
+	CHECK(decoded.empty());
+}
+
+}} // test
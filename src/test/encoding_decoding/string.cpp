@@ -12,6 +12,7 @@
 #include <shift/operator/string.hpp>
 #include <shift/operator/universal.hpp>
 #include <shift/types/var_int.hpp>
+#include <shift/types/string_view.hpp>
 
 #include <test/utility.hpp>
 #include <examples/utility.hpp>
@@ -436,4 +437,48 @@ TEST_CASE( "trying to read a string beyond the size of a source results in an ou
 	}
 }
 
+TEST_CASE( "strings decoded to string_view refer to the characters in the buffer of the source"
+         , "[string, decoding]" )
+{
+	typedef shift::sink<shift::big_endian, shift::static_buffer<256> > sink_type;
+	typedef shift::source<shift::big_endian>                           source_type;
+
+	const std::string first  = "The quick brown fox jumps over the lazy dog";
+	const std::string second = "pack my box";
+	sink_type sink;
+	sink << first
+	     << shift::ostring<shift::variable_length>(second)
+	     << shift::ostring<shift::no_size_field>(first)
+	     << shift::ostring<shift::no_size_field>(second)
+	     << std::string()
+	     << shift::uint8_t(0xAB);
+
+	shift::string_view a, b, c, d, e;
+	shift::uint8_t     end = 0;
+	source_type source(sink.buffer(), sink.size());
+	source >> a
+	       >> shift::istring<shift::variable_length, shift::string_view>(b)
+	       >> shift::istring<shift::no_size_field, shift::string_view>(c, first.size());
+	source % shift::istring<shift::static_size<4>, shift::string_view>(d)
+	       % shift::buffer_position(2 + first.size() + 1 + second.size() + first.size() + second.size(), 7)
+	       % e
+	       % end;
+
+	CHECK(a == first);
+	CHECK(b == second);
+	CHECK(c == first);
+	CHECK(d == "pack");
+	CHECK(e.empty());
+	CHECK(end == 0xAB);
+
+	CHECK(a.data() == reinterpret_cast<const char*>(sink.buffer()) + 2);
+	CHECK(a.str()  == first);
+	CHECK(a != b);
+	CHECK(a <  b);
+	CHECK(d <  b);
+
+	source = source_type(sink.buffer(), 10);
+	CHECK_THROWS_AS(source >> a, const shift::out_of_range&);
+}
+
 }}
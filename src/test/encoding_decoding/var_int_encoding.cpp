@@ -1,15 +1,21 @@
 #include <catch.hpp>
 
+#include <vector>
+#include <iterator>
+
 #include <shift/detail/var_int.hpp>
 #include <shift/sink.hpp>
 #include <shift/source.hpp>
 #include <shift/types/var_int.hpp>
 #include <shift/operator/var_int.hpp>
 #include <shift/buffer/static_buffer.hpp>
+#include <shift/buffer/vector.hpp>
+#include <shift/operator/repeated.hpp>
 #include <shift/utility/const_ref.hpp>
 #include <shift/utility/argument_traits.hpp>
 
 #include <examples/utility.hpp>
+#include <test/utility.hpp>
 
 namespace test { namespace {
 
@@ -906,4 +912,144 @@ TEST_CASE( "variable length encoding and decoding of unsigned integers - var_wid
 }
 
 
+
+TEST_CASE( "var uints are decoded the same whether or not 8 bytes follow them in the source"
+         , "[var_uint]")
+{
+	typedef shift::sink  <shift::little_endian, shift::vector> sink_type;
+	typedef shift::source<shift::little_endian>                source_type;
+
+	for (unsigned int n_bits=0; n_bits<=56; ++n_bits) {
+		CAPTURE(n_bits);
+		const shift::uint64_t value = n_bits == 0 ? 0 : (shift::uint64_t(1) << (n_bits - 1)) | 0x5A5A5A5A5A5A5AULL >> (57 - n_bits);
+
+		sink_type sink;
+		sink << shift::var_int<shift::uint64_t>(value);
+		const std::size_t size = sink.size();
+		CHECK(size == (n_bits == 0 ? 1 : (n_bits + 6) / 7));
+		for (unsigned int i=0; i<8; ++i)
+			sink << shift::uint8_t(0xFF);
+
+		for (unsigned int n_following=0; n_following<=8; ++n_following) {
+			shift::var_int<shift::uint64_t> decoded;
+			source_type source(sink.buffer(), size + n_following);
+			source >> decoded >> pos(size, 7);
+			CHECK(*decoded == value);
+		}
+	}
+}
+
+TEST_CASE( "var uints longer than read_var_uint accepts throw malformed_var_uint whether or not 8 bytes follow them"
+         , "[var_uint]")
+{
+	typedef shift::sink  <shift::little_endian, shift::vector> sink_type;
+	typedef shift::source<shift::little_endian>                source_type;
+
+	sink_type sink;
+	sink << shift::var_int<shift::uint64_t>(1u << 21);
+	for (unsigned int i=0; i<8; ++i)
+		sink << shift::uint8_t(0);
+
+	for (unsigned int n_following=0; n_following<=8; ++n_following) {
+		shift::var_int<shift::uint32_t> decoded;
+		source_type source(sink.buffer(), 4 + n_following);
+		CHECK_THROWS_AS(source >> decoded, const shift::malformed_var_uint&);
+	}
+
+	shift::var_int<shift::uint32_t> decoded;
+	source_type source(sink.buffer(), 3);
+	CHECK_THROWS_AS(source >> decoded, const shift::out_of_range&);
+}
+
+/*
+ * values of 1 to 10 encoded bytes, with runs of small values in between
+ */
+template<typename IntType>
+std::vector<shift::var_int<IntType> > var_int_values(unsigned int n, unsigned int max_bits) {
+	std::vector<shift::var_int<IntType> > values;
+	value_generator generator;
+	for (unsigned int i=0; i<n; ++i) {
+		const shift::uint64_t x = generator();
+		const unsigned int bits = (i / 40) % 3 == 0 ? 7 : static_cast<unsigned int>(x % max_bits) + 1;
+		const shift::uint64_t mask = bits >= 64 ? ~shift::uint64_t(0) : (shift::uint64_t(1) << bits) - 1;
+		shift::uint64_t v = (x >> 3) & mask;
+		if (bits == 7 && i % 5 != 0) v &= 0x3F;
+		values.push_back(shift::var_int<IntType>(static_cast<IntType>(v)));
+	}
+	return values;
+}
+
+template<typename IntType>
+void check_repeated_var_ints(unsigned int max_bits) {
+	typedef shift::sink<shift::big_endian, shift::vector> sink_type;
+	typedef shift::var_int<IntType>                       value_type;
+	typedef std::vector<value_type>                       container_type;
+
+	const container_type values = var_int_values<IntType>(5000, max_bits);
+
+	sink_type element_wise;
+	element_wise << shift::var_int<shift::uint32_t>(static_cast<shift::uint32_t>(values.size()));
+	for (std::size_t i=0; i<values.size(); ++i)
+		element_wise << values[i];
+
+	sink_type from_iterators;
+	from_iterators << shift::orepeated<shift::variable_length, typename container_type::const_iterator>(values.begin(), values.end());
+
+	sink_type from_pointers;
+	from_pointers << shift::orepeated<shift::variable_length, const value_type*>(&values[0], &values[0] + values.size());
+
+	REQUIRE(from_iterators.size() == element_wise.size());
+	REQUIRE(from_pointers .size() == element_wise.size());
+	for (std::size_t i=0; i<element_wise.size(); ++i) {
+		REQUIRE(from_iterators.buffer()[i] == element_wise.buffer()[i]);
+		REQUIRE(from_pointers .buffer()[i] == element_wise.buffer()[i]);
+	}
+
+	check_repeated_round_trip<shift::variable_length, shift::big_endian>(values, 17);
+}
+
+TEST_CASE( "repeated var ints are encoded byte by byte identical to single var ints and decoded to the same values"
+         , "[var_int]")
+{
+	// read_var_uint accepts up to 3 bytes for 4 byte integers and up to 8 bytes for 8 byte integers
+
+	check_repeated_var_ints<shift::uint32_t>(14);
+	check_repeated_var_ints<shift::uint32_t>(21);
+	check_repeated_var_ints<shift::uint64_t>(56);
+	check_repeated_var_ints<long long      >(55);
+}
+
+TEST_CASE( "repeated var ints throw malformed_var_uint and out_of_range like single var ints"
+         , "[var_int]")
+{
+	typedef shift::sink  <shift::little_endian, shift::vector>       sink_type;
+	typedef shift::source<shift::little_endian>                      source_type;
+	typedef shift::var_int<shift::uint32_t>                          value_type;
+	typedef std::vector<value_type>                                  container_type;
+	typedef std::back_insert_iterator<container_type>                inserter_type;
+	typedef shift::irepeated<shift::variable_length, inserter_type> repeated_type;
+
+	sink_type sink;
+	sink << value_type(40);
+	for (unsigned int i=0; i<30; ++i)
+		sink << value_type(i);
+	sink << value_type(1u << 21);
+	for (unsigned int i=0; i<9; ++i)
+		sink << value_type(i);
+
+	container_type decoded;
+	source_type source(sink.buffer(), sink.size());
+	CHECK_THROWS_AS(source >> repeated_type(std::back_inserter(decoded)), const shift::malformed_var_uint&);
+	CHECK(decoded.size() == 30);
+
+	decoded.clear();
+	sink.clear();
+	sink << value_type(40);
+	for (unsigned int i=0; i<39; ++i)
+		sink << value_type(i * 300);
+	source = source_type(sink.buffer(), sink.size() - 1);
+	CHECK_THROWS_AS(source >> repeated_type(std::back_inserter(decoded)), const shift::out_of_range&);
+	CHECK(decoded.size() == 38);
+}
+
 }} // test
@@ -0,0 +1,126 @@
+#include <catch.hpp>
+
+#include <limits>
+#include <string>
+
+#include <shift/buffer/static_buffer.hpp>
+#include <shift/buffer/vector.hpp>
+#include <shift/buffer/counting_buffer.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/length_prefix.hpp>
+#include <shift/operator/string.hpp>
+#include <shift/operator/universal.hpp>
+
+namespace test { namespace {
+
+template<typename SinkType>
+SinkType& write_body(SinkType& sink, unsigned int n) {
+	for (unsigned int i=0; i<n; ++i)
+		sink << static_cast<shift::uint16_t>(i);
+	return sink;
+}
+
+template<typename SizeType>
+void check_length_prefix(unsigned int n) {
+	typedef shift::sink<shift::big_endian, shift::vector> sink_type;
+
+	CAPTURE(n);
+	sink_type body;
+	write_body(body, n);
+	const std::string encoded_body(reinterpret_cast<const char*>(body.buffer()), body.size());
+
+	// the field as written from a temporary sink
+
+	sink_type copied;
+	copied << shift::uint8_t(0xAB) << shift::ostring<SizeType>(encoded_body) << shift::uint8_t(0xCD);
+
+	sink_type patched;
+	patched << shift::uint8_t(0xAB);
+	shift::length_prefix<SizeType, sink_type> prefix(patched);
+	write_body(patched, n);
+	CHECK(prefix.length() == 2 * n);
+	prefix.commit();
+	patched << shift::uint8_t(0xCD);
+
+	REQUIRE(patched.size() == copied.size());
+	for (unsigned int i=0; i<copied.size(); ++i)
+		CHECK(patched.buffer()[i] == copied.buffer()[i]);
+}
+
+TEST_CASE( "length_prefix: the size field is written after the field without a temporary sink"
+         , "[length_prefix]")
+{
+	for (unsigned int n=0; n<300; n+=37) {
+		check_length_prefix<shift::uint16_t>(n);
+		check_length_prefix<shift::uint32_t>(n);
+	}
+	check_length_prefix<shift::uint8_t>(127);
+}
+
+TEST_CASE( "length_prefix: variable_length sizes are padded to the reserved number of bytes and can be decoded"
+         , "[length_prefix]")
+{
+	typedef shift::sink<shift::little_endian, shift::static_buffer<64> > sink_type;
+	typedef shift::source<shift::little_endian>                          source_type;
+
+	sink_type sink;
+	{
+		shift::length_prefix<shift::variable_length, sink_type> prefix(sink, 2);
+		sink << shift::ostring<shift::no_size_field>("abc");
+		prefix.commit();
+	}
+	{
+		shift::length_prefix<shift::variable_length, sink_type> prefix(sink);
+		write_body(sink, 20);
+		prefix.commit();
+	}
+
+	REQUIRE(sink.size() == 2 + 3 + 3 + 40);
+	CHECK(sink.buffer()[0] == 0x83);
+	CHECK(sink.buffer()[1] == 0x00);
+	CHECK(sink.buffer()[5] == 0xA8);
+	CHECK(sink.buffer()[6] == 0x80);
+	CHECK(sink.buffer()[7] == 0x00);
+
+	std::string str;
+	shift::uint16_t last = 0;
+	source_type source(sink.buffer(), sink.size());
+	source >> shift::istring<shift::variable_length>(str);
+	CHECK(str == "abc");
+	CHECK(shift::detail::size_decoder<shift::variable_length>::decode_size(source) == 40);
+	source >> shift::buffer_position(sink.size() - 2, 7) >> last;
+	CHECK(last == 19);
+}
+
+TEST_CASE( "length_prefix: fields that do not fit the size field throw out_of_range"
+         , "[length_prefix]")
+{
+	typedef shift::sink<shift::little_endian, shift::vector>          sink_type;
+	typedef shift::sink<shift::little_endian, shift::counting_buffer> counting_sink_type;
+
+	sink_type sink;
+	shift::length_prefix<shift::uint8_t, sink_type> prefix(sink);
+	write_body(sink, 128);
+	CHECK_THROWS_AS(prefix.commit(), const shift::out_of_range&);
+
+	shift::length_prefix<shift::variable_length, sink_type> var_prefix(sink, 1);
+	write_body(sink, 64);
+	CHECK_THROWS_AS(var_prefix.commit(), const shift::out_of_range&);
+
+	typedef shift::length_prefix<shift::variable_length, sink_type> var_prefix_type;
+	CHECK_THROWS_AS(var_prefix_type(sink, 4), const shift::out_of_range&);
+
+	// the range of 64 bit size fields ends at the largest value out_of_range holds
+	CHECK(shift::detail::length_prefix_encoding<shift::uint8_t >::range_end() == 256u);
+	CHECK(shift::detail::length_prefix_encoding<shift::uint16_t>::range_end() == 65536u);
+	CHECK(shift::detail::length_prefix_encoding<shift::uint64_t>::range_end() == std::numeric_limits<std::size_t>::max());
+
+	counting_sink_type counting;
+	shift::length_prefix<shift::variable_length, counting_sink_type> counted_prefix(counting, 3);
+	write_body(counting, 1000);
+	counted_prefix.commit();
+	CHECK(counting.size() == 2003);
+}
+
+}} // test
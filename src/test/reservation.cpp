@@ -0,0 +1,133 @@
+#include <catch.hpp>
+
+#include <shift/buffer/static_buffer.hpp>
+#include <shift/buffer/buffer_interface.hpp>
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/reservation.hpp>
+#include <shift/operator/universal.hpp>
+
+#include <test/utility.hpp>
+
+namespace test { namespace {
+
+template<typename SinkType>
+SinkType& write_message(SinkType& sink, unsigned int i) {
+	sink << static_cast<shift::uint8_t >(i)
+	     << static_cast<shift::uint16_t>(i * 3)
+	     << static_cast<shift::uint32_t>(i * 7)
+	     << static_cast<double         >(i / 2.0)
+	     << shift::uint12_t(i)
+	     << (i % 2 == 0);
+	return sink;
+}
+
+const unsigned int message_size = 1 + 2 + 4 + 8 + 2 + 1;
+
+template<shift::endianness Endianness, typename BufferType>
+void check_reserved_writes_equal_checked_writes(typename BufferType::initialization_params p1, typename BufferType::initialization_params p2) {
+	typedef shift::sink<Endianness, BufferType> sink_t;
+	sink_t checked (p1);
+	sink_t reserved(p2);
+
+	for (unsigned int i=0; i<5; ++i) {
+		write_message(checked, i);
+		shift::reservation<sink_t> r(reserved, message_size);
+		write_message(r.sink(), i);
+	}
+
+	REQUIRE(reserved.size() == 5 * message_size);
+	REQUIRE(reserved.size() == checked.size());
+	for (unsigned int i=0; i<checked.size(); ++i)
+		CHECK(reserved.buffer()[i] == checked.buffer()[i]);
+}
+
+TEST_CASE( "reservation: writing into a reserved range produces the same content as writing to the sink"
+         , "[reservation]")
+{
+	typedef shift::static_buffer<128> static_buffer_t;
+	check_reserved_writes_equal_checked_writes<shift::little_endian, static_buffer_t>(static_buffer_t::initialization_params(), static_buffer_t::initialization_params());
+	check_reserved_writes_equal_checked_writes<shift::big_endian   , static_buffer_t>(static_buffer_t::initialization_params(), static_buffer_t::initialization_params());
+
+	shift::byte_type b1[128];
+	shift::byte_type b2[128];
+	check_reserved_writes_equal_checked_writes<shift::big_endian, shift::buffer_interface>( shift::buffer_interface::initialization_params(b1, 128)
+	                                                                                      , shift::buffer_interface::initialization_params(b2, 128));
+
+	check_reserved_writes_equal_checked_writes<shift::little_endian, shift::vector>(shift::vector::initialization_params(4), shift::vector::initialization_params(4));
+}
+
+TEST_CASE( "reservation: the position of the sink is taken over on construction and handed back on commit"
+         , "[reservation]")
+{
+	typedef shift::sink<shift::little_endian, shift::static_buffer<32> > sink_t;
+	sink_t sink;
+
+	sink << shift::buffer_position(10);
+	{
+		shift::reservation<sink_t> r(sink, 2);
+		r.sink() << static_cast<shift::uint16_t>(0x0201);
+		r.commit();
+		CHECK(sink.size() == 12);
+	}
+	{
+		shift::reservation<sink_t> r(sink, 2);
+		r.sink() << static_cast<shift::uint16_t>(0x0403);
+	}
+	sink << static_cast<shift::uint8_t>(5);
+
+	CHECK(sink.size() == 15);
+	CHECK(sink.buffer()[10] == 1);
+	CHECK(sink.buffer()[11] == 2);
+	CHECK(sink.buffer()[12] == 3);
+	CHECK(sink.buffer()[13] == 4);
+	CHECK(sink.buffer()[14] == 5);
+}
+
+TEST_CASE( "reservation: writes to the sink after commit are kept when the reservation is destroyed"
+         , "[reservation]")
+{
+	typedef shift::sink<shift::little_endian, shift::static_buffer<32> > sink_t;
+	sink_t sink;
+
+	{
+		shift::reservation<sink_t> r(sink, 4);
+		r.sink() << static_cast<shift::uint32_t>(1);
+		r.commit();
+		sink << static_cast<shift::uint32_t>(2);
+		CHECK(sink.size() == 8);
+	}
+
+	CHECK(sink.size() == 8);
+	CHECK(sink.buffer()[0] == 1);
+	CHECK(sink.buffer()[4] == 2);
+}
+
+TEST_CASE( "reservation: reserving beyond the capacity of a fixed size buffer throws out_of_range, a vector is resized"
+         , "[reservation]")
+{
+	typedef shift::sink<shift::little_endian, shift::static_buffer<32> > static_sink_t;
+	static_sink_t static_sink;
+	static_sink << shift::buffer_position(30);
+
+	try {
+		shift::reservation<static_sink_t> r(static_sink, 3);
+		CHECK(false);
+	} catch (const shift::out_of_range& e) {
+		CHECK(e.value() == 32);
+		CHECK((e.range() == shift::out_of_range::range_type(0, 32)));
+	}
+
+	typedef shift::sink<shift::little_endian, shift::vector> vector_sink_t;
+	vector_sink_t vector_sink(vector_sink_t::initialization_params(8));
+	vector_sink << shift::buffer_position(30);
+	{
+		shift::reservation<vector_sink_t> r(vector_sink, 1000);
+		for (unsigned int i=0; i<1000; ++i)
+			r.sink() << static_cast<shift::uint8_t>(i);
+	}
+	CHECK(vector_sink.size() == 1030);
+	CHECK(vector_sink.buffer()[1029] == static_cast<shift::uint8_t>(999));
+}
+
+}} // test
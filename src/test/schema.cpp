@@ -0,0 +1,332 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include <shift/buffer/static_buffer.hpp>
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/streaming_source.hpp>
+#include <shift/schema.hpp>
+#include <shift/reader/istream_reader.hpp>
+#include <shift/types/cstdint.hpp>
+#include <shift/types/converter.hpp>
+#include <shift/types/fixed_width_uint.hpp>
+
+namespace test { namespace {
+
+enum side { buy = 1, sell = 2 };
+
+struct order {
+	order() : id(), flag(), kind(), urgent(), quantity(), sequence(), direction(), price() {}
+
+	shift::uint8_t  id;
+	shift::uint2_t  flag;
+	shift::uint3_t  kind;
+	bool            urgent;
+	shift::uint16_t quantity;
+	shift::uint32_t sequence;
+	side            direction;
+	double          price;
+};
+
+typedef shift::type_converter <side  , shift::uint3_t>  side_converter;
+typedef shift::scale_converter<double, shift::int32_t>  price_converter;
+
+struct price_params {
+	static price_converter::params get() { return price_converter::params(100.); }
+};
+
+typedef shift::schema< order
+                     , shift::field          <order, shift::uint8_t , &order::id      , 0   >
+                     , shift::field          <order, shift::uint2_t , &order::flag    , 1, 7>
+                     , shift::field          <order, shift::uint3_t , &order::kind    , 1, 2>
+                     , shift::field          <order, bool           , &order::urgent  , 2, 3>
+                     , shift::field          <order, shift::uint16_t, &order::quantity, 3   >
+                     , shift::field          <order, shift::uint32_t, &order::sequence, 5   >
+                     , shift::converted_field<side_converter , order, &order::direction, 2, 7>
+                     , shift::converted_field<price_converter, order, &order::price    , 9, 7, price_params>
+                     > order_schema;
+
+/*
+ * the same layout written field by field
+ */
+template<typename SinkType>
+void write_order(SinkType& sink, const order& value) {
+	sink << shift::buffer_position(0   ) << value.id
+	     << shift::buffer_position(1, 7) << value.flag
+	     << shift::buffer_position(1, 2) << value.kind
+	     << shift::buffer_position(2, 3) << value.urgent
+	     << shift::buffer_position(3   ) << value.quantity
+	     << shift::buffer_position(5   ) << value.sequence
+	     << shift::buffer_position(2, 7) << shift::uint3_t(value.direction)
+	     << shift::buffer_position(9   ) << static_cast<shift::int32_t>(value.price * 100.);
+}
+
+order make_order(unsigned int i) {
+	order value;
+	value.id        = static_cast<shift::uint8_t>(i * 7);
+	value.flag      = i % 4;
+	value.kind      = i % 8;
+	value.urgent    = i % 3 == 0;
+	value.quantity  = static_cast<shift::uint16_t>(i * 1000 + 1);
+	value.sequence  = 4000000000u - i;
+	value.direction = i % 2 ? buy : sell;
+	value.price     = 99.25 + i;
+	return value;
+}
+
+void check_equal(const order& x, const order& y) {
+	CHECK(x.id           == y.id          );
+	CHECK(x.flag.get()   == y.flag.get()  );
+	CHECK(x.kind.get()   == y.kind.get()  );
+	CHECK(x.urgent       == y.urgent      );
+	CHECK(x.quantity     == y.quantity    );
+	CHECK(x.sequence     == y.sequence    );
+	CHECK(x.direction    == y.direction   );
+	CHECK(x.price        == y.price       );
+}
+
+template<shift::endianness Endianness>
+void check_schema() {
+	typedef shift::sink  <Endianness, shift::vector> sink_type;
+	typedef shift::source<Endianness>                source_type;
+
+	for (unsigned int i=0; i<20; ++i) {
+		CAPTURE(i);
+		const order value = make_order(i);
+
+		sink_type written;
+		write_order(written, value);
+
+		sink_type sink;
+		order_schema::encode(sink, value);
+
+		REQUIRE(sink.size() == written.size());
+		for (unsigned int k=0; k<sink.size(); ++k)
+			CHECK(sink.buffer()[k] == written.buffer()[k]);
+
+		order decoded;
+		source_type source(sink.buffer(), sink.size());
+		order_schema::decode(source, decoded);
+		check_equal(decoded, value);
+	}
+}
+
+TEST_CASE( "schema: records are encoded like their fields written one by one"
+         , "[schema]")
+{
+	const std::size_t size = order_schema::size;
+	CHECK(size == 13);
+	check_schema<shift::little_endian>();
+	check_schema<shift::big_endian   >();
+}
+
+/*
+ * a 16 byte frame held in two 64 bit words, with fields that cross bytes and the boundary of the words.
+ * it is decoded like its fields read one by one
+ */
+typedef shift::fixed_width_uint<shift::uint32_t, 20> uint20_t;
+typedef shift::fixed_width_uint<shift::uint64_t, 17> uint17_t;
+
+struct frame {
+	frame() : id(), channel(), length(), counter(), valid(), timestamp(), value(), checksum(), offset() {}
+
+	shift::uint12_t id;
+	shift::uint4_t  channel;
+	shift::uint16_t length;
+	uint20_t        counter;
+	bool            valid;
+	uint17_t        timestamp;
+	float           value;
+	shift::uint7_t  checksum;
+	shift::int16_t  offset;
+};
+
+typedef shift::schema< frame
+                     , shift::field<frame, shift::uint12_t, &frame::id       , 0   >
+                     , shift::field<frame, shift::uint4_t , &frame::channel  , 1, 3>
+                     , shift::field<frame, shift::uint16_t, &frame::length   , 2   >
+                     , shift::field<frame, uint20_t       , &frame::counter  , 4, 5>
+                     , shift::field<frame, bool           , &frame::valid    , 6, 1>
+                     , shift::field<frame, uint17_t       , &frame::timestamp, 6, 0>
+                     , shift::field<frame, float          , &frame::value    , 9   >
+                     , shift::field<frame, shift::uint7_t , &frame::checksum , 13, 6>
+                     , shift::field<frame, shift::int16_t , &frame::offset   , 14  >
+                     > frame_schema;
+
+template<typename SinkType>
+void write_frame(SinkType& sink, const frame& value) {
+	sink << shift::buffer_position(0 , 7) << value.id
+	     << shift::buffer_position(1 , 3) << value.channel
+	     << shift::buffer_position(2    ) << value.length
+	     << shift::buffer_position(4 , 5) << value.counter
+	     << shift::buffer_position(6 , 1) << value.valid
+	     << shift::buffer_position(6 , 0) << value.timestamp
+	     << shift::buffer_position(9    ) << value.value
+	     << shift::buffer_position(13, 6) << value.checksum
+	     << shift::buffer_position(14   ) << value.offset;
+}
+
+template<typename SourceType>
+void read_frame(SourceType& source, frame& value) {
+	source >> shift::buffer_position(0 , 7) >> value.id
+	       >> shift::buffer_position(1 , 3) >> value.channel
+	       >> shift::buffer_position(2    ) >> value.length
+	       >> shift::buffer_position(4 , 5) >> value.counter
+	       >> shift::buffer_position(6 , 1) >> value.valid
+	       >> shift::buffer_position(6 , 0) >> value.timestamp
+	       >> shift::buffer_position(9    ) >> value.value
+	       >> shift::buffer_position(13, 6) >> value.checksum
+	       >> shift::buffer_position(14   ) >> value.offset;
+}
+
+frame make_frame(shift::uint32_t seed) {
+	frame value;
+	value.id        = static_cast<shift::uint16_t>(seed);
+	value.channel   = static_cast<shift::uint8_t >(seed >> 12);
+	value.length    = static_cast<shift::uint16_t>(seed * 40503u);
+	value.counter   = seed * 2654435761u;
+	value.valid     = (seed >> 3) % 2 == 1;
+	value.timestamp = static_cast<shift::uint64_t>(seed) * 0x9E3779B97F4A7C15ull;
+	value.value     = static_cast<float>(seed % 1000) * 0.125f - 50.f;
+	value.checksum  = static_cast<shift::uint8_t >(seed >> 5);
+	value.offset    = static_cast<shift::int16_t >(seed * 31u);
+	return value;
+}
+
+template<shift::endianness Endianness>
+void check_frame_schema() {
+	typedef shift::sink  <Endianness, shift::vector> sink_type;
+	typedef shift::source<Endianness>                source_type;
+
+	shift::uint32_t seed = 12345;
+	for (unsigned int i=0; i<200; ++i) {
+		CAPTURE(i);
+		seed = seed * 1103515245u + 12345u;
+		const frame value = make_frame(seed);
+
+		sink_type written;
+		write_frame(written, value);
+
+		sink_type sink;
+		frame_schema::encode(sink, value);
+
+		REQUIRE(sink.size() == written.size());
+		for (unsigned int k=0; k<sink.size(); ++k)
+			CHECK(sink.buffer()[k] == written.buffer()[k]);
+
+		frame read;
+		source_type written_source(written.buffer(), written.size());
+		read_frame(written_source, read);
+
+		frame decoded;
+		source_type source(sink.buffer(), sink.size());
+		frame_schema::decode(source, decoded);
+		CHECK(decoded.id.get()        == read.id.get()       );
+		CHECK(decoded.channel.get()   == read.channel.get()  );
+		CHECK(decoded.length          == read.length         );
+		CHECK(decoded.counter.get()   == read.counter.get()  );
+		CHECK(decoded.valid           == read.valid          );
+		CHECK(decoded.timestamp.get() == read.timestamp.get());
+		CHECK(decoded.value           == read.value          );
+		CHECK(decoded.checksum.get()  == read.checksum.get() );
+		CHECK(decoded.offset          == read.offset         );
+	}
+}
+
+TEST_CASE( "schema: records of up to 16 bytes are encoded like their fields written one by one"
+         , "[schema]")
+{
+	const std::size_t size = frame_schema::size;
+	CHECK(size == 16);
+	check_frame_schema<shift::little_endian>();
+	check_frame_schema<shift::big_endian   >();
+}
+
+struct stamped_record {
+	stamped_record() : stamp() {}
+
+	shift::uint64_t stamp;
+};
+
+typedef shift::schema< stamped_record
+                     , shift::field<stamped_record, shift::uint64_t, &stamped_record::stamp, 13>
+                     > stamped_record_schema;
+
+TEST_CASE( "schema: records of more than 16 bytes are encoded field by field"
+         , "[schema]")
+{
+	typedef shift::sink  <shift::big_endian, shift::vector> sink_type;
+	typedef shift::source<shift::big_endian>                source_type;
+
+	stamped_record value;
+	value.stamp = 0x0102030405060708ull;
+
+	sink_type written;
+	written << shift::buffer_position(13) << value.stamp;
+
+	sink_type sink;
+	stamped_record_schema::encode(sink, value);
+
+	const std::size_t size = stamped_record_schema::size;
+	CHECK(size == 21);
+	REQUIRE(sink.size() == written.size());
+	for (unsigned int k=0; k<sink.size(); ++k)
+		CHECK(sink.buffer()[k] == written.buffer()[k]);
+
+	stamped_record decoded;
+	source_type source(sink.buffer(), sink.size());
+	stamped_record_schema::decode(source, decoded);
+	CHECK(decoded.stamp == value.stamp);
+}
+
+TEST_CASE( "schema: records follow each other from the current position"
+         , "[schema]")
+{
+	typedef shift::sink  <shift::big_endian, shift::static_buffer<128> > sink_type;
+	typedef shift::streaming_source<shift::big_endian>                   source_type;
+
+	sink_type sink;
+	sink << shift::uint8_t(0xAB);
+	for (unsigned int i=0; i<3; ++i)
+		order_schema::encode(sink, make_order(i));
+	const std::size_t size = order_schema::size;
+	REQUIRE(sink.size() == 1 + 3 * size);
+
+	std::istringstream stream(std::string(reinterpret_cast<const char*>(sink.buffer()), sink.size()));
+	shift::istream_reader reader(stream);
+	source_type source(reader, 5);
+
+	shift::uint8_t first = 0;
+	order decoded;
+	source >> first;
+	CHECK(first == 0xAB);
+	CHECK(order_schema::validate(source));
+	order_schema::skip(source);
+	order_schema::decode(source, decoded);
+	check_equal(decoded, make_order(1));
+	CHECK(order_schema::validate(source));
+	order_schema::decode(source, decoded);
+	check_equal(decoded, make_order(2));
+	CHECK(!order_schema::validate(source));
+}
+
+TEST_CASE( "schema: incomplete records throw out_of_range"
+         , "[schema]")
+{
+	typedef shift::sink  <shift::little_endian, shift::vector> sink_type;
+	typedef shift::source<shift::little_endian>                source_type;
+
+	sink_type sink;
+	order_schema::encode(sink, make_order(1));
+
+	order decoded;
+	source_type source(sink.buffer(), sink.size() - 1);
+	CHECK(!order_schema::validate(source));
+	CHECK_THROWS_AS(order_schema::decode(source, decoded), const shift::out_of_range&);
+	CHECK_THROWS_AS(order_schema::skip(source), const shift::out_of_range&);
+}
+
+}} // test
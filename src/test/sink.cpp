@@ -1,6 +1,9 @@
 #include <catch.hpp>
 
+#include <cstring>
+
 #include <shift/buffer/static_buffer.hpp>
+#include <shift/buffer/buffer_interface.hpp>
 #include <shift/sink.hpp>
 
 #include <test/utility.hpp>
@@ -241,4 +244,55 @@ TEST_CASE( "sink: out_of_range is thrown when trying to 'stream' to a position b
 	test_out_of_range_when_inserting_beyond_buffer_interface_capacity   <shift::uint64_t, 64>(18000000);
 }
 
+/*
+ * a buffer whose unwritten bytes are not zero, like uninitialized memory
+ */
+class dirty_buffer : public shift::buffer_interface {
+public:
+
+	static const unsigned int size = 8;
+
+	struct initialization_params {};
+
+	dirty_buffer(initialization_params = initialization_params())
+	: buffer_interface(buffer_interface::initialization_params(buffer_, size))
+	{
+		std::memset(buffer_, 0xFF, size);
+	}
+
+private:
+	shift::byte_type buffer_[size];
+};
+
+TEST_CASE( "sink: a cleared sink encodes like a newly constructed one"
+         , "sink")
+{
+	typedef shift::sink<shift::little_endian, shift::static_buffer<8> > sink_t;
+
+	sink_t fresh;
+	fresh << true << shift::uint4_t(3);
+
+	sink_t cleared;
+	cleared << static_cast<shift::uint32_t>(0xFFFFFFFF) << false;
+	cleared.clear();
+	cleared << true << shift::uint4_t(3);
+
+	REQUIRE(cleared.size() == fresh.size());
+	for (unsigned int i=0; i<fresh.size(); ++i)
+		CHECK(cleared.buffer()[i] == fresh.buffer()[i]);
+}
+
+TEST_CASE( "sink: a bool does not take over bits of the buffer beyond the written size"
+         , "sink")
+{
+	typedef shift::sink<shift::little_endian, dirty_buffer> sink_t;
+	sink_t sink;
+
+	sink << false << true;
+
+	REQUIRE(sink.size() == 2);
+	CHECK(sink.buffer()[0] == 0x00);
+	CHECK(sink.buffer()[1] == 0x80);
+}
+
 }} // test
@@ -0,0 +1,296 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <iterator>
+
+#include <shift/buffer/vector.hpp>
+#include <shift/sink.hpp>
+#include <shift/source.hpp>
+#include <shift/streaming_source.hpp>
+#include <shift/reader/reader.hpp>
+#include <shift/reader/fd_reader.hpp>
+#include <shift/reader/istream_reader.hpp>
+#include <shift/operator/universal.hpp>
+#include <shift/operator/string.hpp>
+#include <shift/operator/repeated.hpp>
+
+#include <test/utility.hpp>
+
+namespace test { namespace {
+
+/*
+ * hands out the content of a buffer in pieces of at most max_piece bytes
+ */
+class piecewise_reader : public shift::reader {
+public:
+	piecewise_reader(const shift::byte_type* p, std::size_t size, std::size_t max_piece)
+	: p_(p), size_(size), max_piece_(max_piece), n_calls(0) {}
+
+	std::size_t read(shift::byte_type* p, std::size_t n) {
+		++n_calls;
+		if (n > max_piece_) n = max_piece_;
+		if (n > size_     ) n = size_;
+		std::memcpy(p, p_, n);
+		p_    += n;
+		size_ -= n;
+		return n;
+	}
+
+private:
+	const shift::byte_type* p_;
+	std::size_t             size_;
+	std::size_t             max_piece_;
+public:
+	unsigned int            n_calls;
+};
+
+/*
+ * stream buffer over a pipe of which the writer is still open, like open_pipe_reader
+ */
+class open_pipe_streambuf : public std::streambuf {
+public:
+	open_pipe_streambuf(const shift::byte_type* p, std::size_t size)
+	: data_(reinterpret_cast<const char*>(p), size), delivered_(false), n_blocking_reads(0) {}
+
+protected:
+	int_type underflow() {
+		if (delivered_) {
+			++n_blocking_reads;
+			return traits_type::eof();
+		}
+		delivered_ = true;
+		char* begin = &data_[0];
+		setg(begin, begin, begin + data_.size());
+		return traits_type::to_int_type(*begin);
+	}
+
+private:
+	std::string data_;
+	bool        delivered_;
+public:
+	unsigned int n_blocking_reads;
+};
+
+typedef std::vector<shift::uint16_t> container_type;
+
+template<typename SinkType>
+void encode_records(SinkType& sink, unsigned int n) {
+	for (unsigned int i=0; i<n; ++i) {
+		container_type values(i % 7, static_cast<shift::uint16_t>(i));
+		sink << static_cast<shift::uint32_t>(i)
+		     << shift::uint12_t(i)
+		     << (i % 2 == 0)
+		     << std::string(i % 13, 'a' + i % 26)
+		     << shift::orepeated<shift::uint8_t, container_type::const_iterator>(values.begin(), values.end())
+		     << static_cast<double>(i * 0.5);
+	}
+}
+
+template<typename SourceType>
+void check_records(SourceType& source, unsigned int n) {
+	for (unsigned int i=0; i<n; ++i) {
+		shift::uint32_t u32 = 0;
+		shift::uint12_t u12;
+		bool            b   = false;
+		std::string     str;
+		container_type  values;
+		double          d   = 0;
+		source >> u32 >> u12 >> b >> str
+		       >> shift::irepeated<shift::uint8_t, std::back_insert_iterator<container_type> >(std::back_inserter(values))
+		       >> d;
+
+		REQUIRE(u32  == i);
+		REQUIRE(*u12 == i % 4096);
+		REQUIRE(b    == (i % 2 == 0));
+		REQUIRE(str  == std::string(i % 13, 'a' + i % 26));
+		REQUIRE(values == container_type(i % 7, static_cast<shift::uint16_t>(i)));
+		REQUIRE(d    == i * 0.5);
+	}
+}
+
+TEST_CASE( "streaming source: fields are decoded across refills of a small window"
+         , "[streaming_source]")
+{
+	typedef shift::sink<shift::little_endian, shift::vector> sink_t;
+	typedef shift::streaming_source<shift::little_endian>    source_t;
+
+	const unsigned int n = 2000;
+	sink_t sink;
+	encode_records(sink, n);
+
+	const std::size_t pieces[] = { 1, 3, 8, 1000 };
+	for (unsigned int i=0; i<sizeof(pieces)/sizeof(pieces[0]); ++i) {
+		CAPTURE(pieces[i]);
+		piecewise_reader reader(sink.buffer(), sink.size(), pieces[i]);
+		source_t source(reader, 4);
+		check_records(source, n);
+	}
+}
+
+TEST_CASE( "streaming source: the window grows to the size of the largest field"
+         , "[streaming_source]")
+{
+	typedef shift::sink<shift::little_endian, shift::vector> sink_t;
+	typedef shift::streaming_source<shift::little_endian>    source_t;
+
+	const std::string long_string(10000, 'x');
+	sink_t sink;
+	sink << shift::uint8_t(1) << shift::ostring<shift::uint16_t>(long_string) << shift::uint8_t(2);
+
+	piecewise_reader reader(sink.buffer(), sink.size(), 100);
+	source_t source(reader, 16);
+
+	shift::uint8_t a = 0, b = 0;
+	std::string    str;
+	source >> a >> shift::istring<shift::uint16_t>(str) >> b;
+
+	CHECK(a   == 1);
+	CHECK(str == long_string);
+	CHECK(b   == 2);
+	CHECK(source.size() == sink.size());
+}
+
+TEST_CASE( "streaming source: reading beyond the end of the input throws out_of_range, positions can be skipped"
+         , "[streaming_source]")
+{
+	const shift::byte_type data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	typedef shift::streaming_source<shift::big_endian> source_t;
+
+	{
+		piecewise_reader reader(data, sizeof(data), 3);
+		source_t source(reader, 4);
+
+		shift::uint8_t value = 0;
+		source >> shift::buffer_position(7) >> value;
+		CHECK(value == 8);
+
+		shift::uint32_t too_large = 0;
+		try {
+			source >> too_large;
+			CHECK(false);
+		} catch (const shift::out_of_range& e) {
+			CHECK(e.value() == 11);
+		}
+	}
+
+	{
+		piecewise_reader reader(data, sizeof(data), 3);
+		source_t source(reader, 4);
+		shift::uint8_t value = 0;
+		CHECK_THROWS_AS(source >> shift::buffer_position(10) >> value, const shift::out_of_range&);
+	}
+}
+
+TEST_CASE( "streaming source: bit fields at the end of the input do not wait for further bytes"
+         , "[streaming_source]")
+{
+	typedef shift::sink<shift::little_endian, shift::vector> sink_t;
+	typedef shift::streaming_source<shift::little_endian>    source_t;
+
+	sink_t sink;
+	sink << shift::uint8_t(0xAB) << shift::uint3_t(5) << shift::uint12_t(0xABC) << shift::uint7_t(0x55);
+	REQUIRE(sink.size() == 5);
+
+	open_pipe_reader reader(sink.buffer(), sink.size());
+	source_t source(reader, 4);
+
+	shift::uint8_t  first = 0;
+	shift::uint3_t  u3;
+	shift::uint12_t u12;
+	shift::uint7_t  u7;
+	source >> first >> u3 >> u12 >> u7;
+
+	CHECK(first == 0xAB);
+	CHECK(*u3   == 5);
+	CHECK(*u12  == 0xABC);
+	CHECK(*u7   == 0x55);
+	CHECK(reader.n_blocking_reads == 0);
+}
+
+TEST_CASE( "streaming source: an istream_reader returns the bytes the stream has without waiting for more"
+         , "[streaming_source]")
+{
+	typedef shift::sink<shift::little_endian, shift::vector> sink_t;
+	typedef shift::streaming_source<shift::little_endian>    source_t;
+
+	sink_t sink;
+	sink << shift::uint8_t(0xAB) << shift::uint3_t(5) << shift::uint12_t(0xABC) << shift::uint7_t(0x55);
+	REQUIRE(sink.size() == 5);
+
+	open_pipe_streambuf buffer(sink.buffer(), sink.size());
+	std::istream        stream(&buffer);
+	shift::istream_reader reader(stream);
+	source_t source(reader);
+
+	shift::uint8_t  first = 0;
+	shift::uint3_t  u3;
+	shift::uint12_t u12;
+	shift::uint7_t  u7;
+	source >> first >> u3 >> u12 >> u7;
+
+	CHECK(first == 0xAB);
+	CHECK(*u3   == 5);
+	CHECK(*u12  == 0xABC);
+	CHECK(*u7   == 0x55);
+	CHECK(buffer.n_blocking_reads == 0);
+}
+
+TEST_CASE( "streaming source: a source over memory is a value, its copies decode independently"
+         , "[streaming_source]")
+{
+	const shift::byte_type data[] = { 1, 2, 3, 4 };
+
+	shift::source<shift::little_endian> memory_source(data, sizeof(data));
+	shift::uint8_t value = 0;
+	memory_source >> value;
+	CHECK(value == 1);
+
+	shift::source<shift::little_endian> copy(memory_source);
+	copy >> value;
+	CHECK(value == 2);
+	memory_source >> value;
+	CHECK(value == 2);
+
+	piecewise_reader reader(data, sizeof(data), 2);
+	shift::streaming_source<shift::little_endian> source(reader, 4);
+	source >> value;
+	CHECK(value == 1);
+}
+
+TEST_CASE( "streaming source: data can be read from a file descriptor and from a std::istream"
+         , "[streaming_source]")
+{
+	typedef shift::sink<shift::little_endian, shift::vector> sink_t;
+	typedef shift::streaming_source<shift::little_endian>    source_t;
+
+	const unsigned int n = 500;
+	sink_t sink;
+	encode_records(sink, n);
+	const std::string encoded(reinterpret_cast<const char*>(sink.buffer()), sink.size());
+
+	{
+		std::FILE* file = std::tmpfile();
+		REQUIRE(file != NULL);
+		REQUIRE(std::fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size());
+		std::fflush(file);
+		std::rewind(file);
+
+		shift::fd_reader reader(fileno(file));
+		source_t source(reader, 64);
+		check_records(source, n);
+		std::fclose(file);
+	}
+
+	{
+		std::istringstream stream(encoded);
+		shift::istream_reader reader(stream);
+		source_t source(reader, 64);
+		check_records(source, n);
+	}
+}
+
+}} // test
@@ -2,15 +2,24 @@
 #define SHIFT_TEST_UTILITY_HPP_
 
 #include <cstring>
+#include <cstddef>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <vector>
+#include <iterator>
 
 #include <catch.hpp>
 
 #include <shift/buffer/static_buffer.hpp>
+#include <shift/buffer/vector.hpp>
 #include <shift/sink.hpp>
 #include <shift/source.hpp>
+#include <shift/streaming_source.hpp>
 #include <shift/operator/universal.hpp>
+#include <shift/operator/repeated.hpp>
+#include <shift/reader/reader.hpp>
+#include <shift/reader/istream_reader.hpp>
 
 namespace test {
 namespace detail {
@@ -377,7 +386,7 @@ void test_out_of_range_when_inserting_beyond_static_buffer_capacity(const T valu
 		check_all_zero(sink.buffer(), buffer_capacity);
 		CHECK(true);
 		CHECK(e.value() == buffer_capacity);
-		CHECK((e.range() == std::make_pair<unsigned int, unsigned int>(0, buffer_capacity)));
+		CHECK((e.range() == shift::out_of_range::range_type(0, buffer_capacity)));
 	}
 
 	try {
@@ -387,7 +396,7 @@ void test_out_of_range_when_inserting_beyond_static_buffer_capacity(const T valu
 		check_all_zero(sink.buffer(), buffer_capacity);
 		CHECK(true);
 		CHECK(e.value() == buffer_capacity + n_bytes - 1);
-		CHECK((e.range() == std::make_pair<unsigned int, unsigned int>(0, buffer_capacity)));
+		CHECK((e.range() == shift::out_of_range::range_type(0, buffer_capacity)));
 	}
 }
 
@@ -408,7 +417,7 @@ void test_out_of_range_when_inserting_beyond_buffer_interface_capacity(const Uin
 		check_all_zero(sink.buffer(), buffer_capacity);
 		CHECK(true);
 		CHECK(e.value() == buffer_capacity);
-		CHECK((e.range() == std::make_pair<unsigned int, unsigned int>(0, buffer_capacity)));
+		CHECK((e.range() == shift::out_of_range::range_type(0, buffer_capacity)));
 	}
 
 	try {
@@ -418,7 +427,7 @@ void test_out_of_range_when_inserting_beyond_buffer_interface_capacity(const Uin
 		check_all_zero(sink.buffer(), buffer_capacity);
 		CHECK(true);
 		CHECK(e.value() == buffer_capacity + n_bytes - 1);
-		CHECK((e.range() == std::make_pair<unsigned int, unsigned int>(0, buffer_capacity)));
+		CHECK((e.range() == shift::out_of_range::range_type(0, buffer_capacity)));
 	}
 }
 
@@ -442,7 +451,7 @@ void test_out_of_range_when_extracting_beyond_static_buffer_capacity() {
 		CHECK(true);
 		CHECK((v == 0));
 		CHECK(e.value() == buffer_capacity);
-		CHECK((e.range() == std::make_pair<unsigned int, unsigned int>(0, buffer_capacity)));
+		CHECK((e.range() == shift::out_of_range::range_type(0, buffer_capacity)));
 	}
 
 	try {
@@ -452,7 +461,7 @@ void test_out_of_range_when_extracting_beyond_static_buffer_capacity() {
 		CHECK(true);
 		CHECK((v == 0));
 		CHECK(e.value() == buffer_capacity + n_bytes - 1);
-		CHECK((e.range() == std::make_pair<unsigned int, unsigned int>(0, buffer_capacity)));
+		CHECK((e.range() == shift::out_of_range::range_type(0, buffer_capacity)));
 	}
 }
 
@@ -491,7 +500,7 @@ void test_consecutive_inserting(const T start_value) {
 	for (T i=0; i<buffer_capacity/n_bytes; ++i) {
 		const T v = start_value + i;
 		sink << v;
-		CHECK(sink.size() == (i+1)*n_bytes);
+		CHECK(sink.size() == static_cast<std::size_t>((i+1)*n_bytes));
 	}
 
 	for (T i=0; i<buffer_capacity/n_bytes; ++i) {
@@ -503,6 +512,92 @@ void test_consecutive_inserting(const T start_value) {
 }
 
 
+/*
+ * xorshift generator for the values of the codec tests, yields the same sequence on every platform
+ */
+class value_generator {
+public:
+	value_generator() : x_(88172645463325252ULL) {}
+
+	shift::uint64_t operator()() {
+		x_ ^= x_ << 13; x_ ^= x_ >> 7; x_ ^= x_ << 17;
+		return x_;
+	}
+
+private:
+	shift::uint64_t x_;
+};
+
+/*
+ * encodes values as a repeated field followed by a marker byte, then decodes them from a source over
+ * memory into a back inserter and into an array, and from a streaming_source with a window of
+ * window_capacity bytes. returns the size of the repeated field
+ */
+template<typename SizeType, shift::endianness Endianness, typename T>
+std::size_t check_repeated_round_trip(const std::vector<T>& values, std::size_t window_capacity) {
+	typedef shift::sink  <Endianness, shift::vector>   sink_type;
+	typedef shift::source<Endianness>                  source_type;
+	typedef std::vector<T>                             container_type;
+	typedef std::back_insert_iterator<container_type> inserter_type;
+
+	CAPTURE(values.size());
+	sink_type sink;
+	sink << shift::orepeated<SizeType, typename container_type::const_iterator>(values.begin(), values.end()) << shift::uint8_t(0xAB);
+
+	container_type decoded;
+	shift::uint8_t end = 0;
+	source_type source(sink.buffer(), sink.size());
+	source >> shift::irepeated<SizeType, inserter_type>(std::back_inserter(decoded)) >> end;
+	CHECK(decoded == values);
+	CHECK(end == 0xAB);
+
+	container_type array(values.size() + 1);
+	unsigned int size = 0;
+	source = source_type(sink.buffer(), sink.size());
+	source >> shift::irepeated<SizeType, T*>(&array[0], size);
+	CHECK(size == values.size());
+	array.resize(values.size());
+	CHECK(array == values);
+
+	std::istringstream stream(std::string(reinterpret_cast<const char*>(sink.buffer()), sink.size()));
+	shift::istream_reader reader(stream);
+	shift::streaming_source<Endianness> streaming(reader, window_capacity);
+	decoded.clear();
+	end = 0;
+	streaming >> shift::irepeated<SizeType, inserter_type>(std::back_inserter(decoded)) >> end;
+	CHECK(decoded == values);
+	CHECK(end == 0xAB);
+
+	return sink.size() - 1;
+}
+
+/*
+ * like a pipe of which the writer is still open: once the data is consumed, a further read would
+ * block. it is counted and returns nothing instead
+ */
+class open_pipe_reader : public shift::reader {
+public:
+	open_pipe_reader(const shift::byte_type* p, std::size_t size)
+	: p_(p), size_(size), n_blocking_reads(0) {}
+
+	std::size_t read(shift::byte_type* p, std::size_t n) {
+		if (size_ == 0) {
+			++n_blocking_reads;
+			return 0;
+		}
+		if (n > size_) n = size_;
+		std::memcpy(p, p_, n);
+		p_    += n;
+		size_ -= n;
+		return n;
+	}
+
+private:
+	const shift::byte_type* p_;
+	std::size_t             size_;
+public:
+	unsigned int            n_blocking_reads;
+};
 
 } // test
 